@@ -0,0 +1,238 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+#include "demand-profile.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("DemandProfile");
+
+// Factor floor keeping intervals finite during idle periods.
+const double DemandProfile::m_minFactor = 0.001;
+
+DemandProfile::DemandProfile ()
+  : m_type (LINEAR),
+  m_period (1),
+  m_amplitude (0),
+  m_shift (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+Ptr<DemandProfile>
+DemandProfile::Parse (std::string spec)
+{
+  NS_LOG_FUNCTION (spec);
+
+  // Ignore surrounding blanks left by the slice config parser.
+  size_t first = spec.find_first_not_of (" \t");
+  size_t last = spec.find_last_not_of (" \t");
+  spec = (first == std::string::npos) ? "" :
+    spec.substr (first, last - first + 1);
+  if (spec.empty ())
+    {
+      return 0;
+    }
+
+  // Split the string into the type and colon-separated numbers per item.
+  size_t pos = spec.find (':');
+  NS_ABORT_MSG_IF (pos == std::string::npos,
+                   "Missing profile type in demand profile " << spec);
+  std::string typeStr = spec.substr (0, pos);
+  std::vector<std::vector<double> > items;
+  std::istringstream itemStream (spec.substr (pos + 1));
+  std::string itemStr;
+  while (std::getline (itemStream, itemStr, '/'))
+    {
+      std::vector<double> values;
+      std::istringstream valueStream (itemStr);
+      std::string valueStr;
+      while (std::getline (valueStream, valueStr, ':'))
+        {
+          char *end;
+          double value = std::strtod (valueStr.c_str (), &end);
+          NS_ABORT_MSG_IF (valueStr.empty () || *end != '\0',
+                           "Invalid number '" << valueStr <<
+                           "' in demand profile " << spec);
+          values.push_back (value);
+        }
+      items.push_back (values);
+    }
+
+  Ptr<DemandProfile> profile = Create<DemandProfile> ();
+  if (typeStr == "pwl" || typeStr == "step")
+    {
+      profile->m_type = (typeStr == "pwl") ? LINEAR : STEP;
+      for (auto const &values : items)
+        {
+          NS_ABORT_MSG_IF (values.size () != 2,
+                           "Expected time:factor points in demand profile " <<
+                           spec);
+          NS_ABORT_MSG_IF (!profile->m_points.empty ()
+                           && values [0] < profile->m_points.back ().time,
+                           "Unsorted points in demand profile " << spec);
+          profile->m_points.push_back ({values [0], values [1]});
+        }
+      NS_ABORT_MSG_IF (profile->m_points.empty (),
+                       "No points in demand profile " << spec);
+    }
+  else if (typeStr == "sin")
+    {
+      NS_ABORT_MSG_IF (items.size () != 1 || items [0].size () < 2
+                       || items [0].size () > 3 || items [0][0] <= 0,
+                       "Expected period:amplitude[:shift] in demand profile " <<
+                       spec);
+      profile->m_type = SINE;
+      profile->m_period = items [0][0];
+      profile->m_amplitude = items [0][1];
+      profile->m_shift = items [0].size () == 3 ? items [0][2] : 0;
+    }
+  else
+    {
+      NS_ABORT_MSG ("Unknown type '" << typeStr << "' in demand profile " <<
+                    spec);
+    }
+  return profile;
+}
+
+double
+DemandProfile::GetFactor (Time time) const
+{
+  double t = time.GetSeconds ();
+  double factor;
+  if (m_type == SINE)
+    {
+      factor = 1 + m_amplitude * std::sin (
+          2 * M_PI * (t - m_shift) / m_period);
+    }
+  else if (t <= m_points.front ().time)
+    {
+      factor = m_points.front ().factor;
+    }
+  else if (t >= m_points.back ().time)
+    {
+      factor = m_points.back ().factor;
+    }
+  else
+    {
+      // Find the first point after t. There are few points, so a linear
+      // search is fine here.
+      size_t i = 1;
+      while (m_points [i].time <= t)
+        {
+          i++;
+        }
+      const Point &p0 = m_points [i - 1];
+      const Point &p1 = m_points [i];
+      factor = (m_type == STEP) ? p0.factor :
+        p0.factor + (p1.factor - p0.factor) * (t - p0.time) /
+        (p1.time - p0.time);
+    }
+  return std::max (factor, m_minFactor);
+}
+
+Time
+DemandProfile::GetNextTime (Time from, Time interval) const
+{
+  double t = from.GetSeconds ();
+  double work = interval.GetSeconds ();
+  while (true)
+    {
+      double end, f0, f1;
+      GetPiece (t, end, f0, f1);
+      if (std::isinf (end))
+        {
+          return Seconds (t + work / f0);
+        }
+
+      double area = (f0 + f1) / 2 * (end - t);
+      if (area >= work)
+        {
+          // Solve f0 * x + a * x^2 = work for the factor ramp in this piece.
+          double a = (f1 - f0) / (2 * (end - t));
+          double delta = std::max (f0 * f0 + 4 * a * work, 0.0);
+          return Seconds (t + 2 * work / (f0 + std::sqrt (delta)));
+        }
+      work -= area;
+      t = end;
+    }
+}
+
+void
+DemandProfile::GetPiece (double t, double &end, double &f0, double &f1) const
+{
+  if (m_type == SINE)
+    {
+      double step = m_period / 32;
+      end = m_shift + (std::floor ((t - m_shift) / step) + 1) * step;
+      if (end <= t)
+        {
+          end += step;
+        }
+      f0 = GetFactor (Seconds (t));
+      f1 = GetFactor (Seconds (end));
+      return;
+    }
+
+  if (t < m_points.front ().time)
+    {
+      end = m_points.front ().time;
+      f0 = f1 = std::max (m_points.front ().factor, m_minFactor);
+      return;
+    }
+
+  // Find the first point after t.
+  size_t i = 1;
+  while (i < m_points.size () && m_points [i].time <= t)
+    {
+      i++;
+    }
+  if (i == m_points.size ())
+    {
+      end = std::numeric_limits<double>::infinity ();
+      f0 = f1 = std::max (m_points.back ().factor, m_minFactor);
+      return;
+    }
+
+  const Point &p0 = m_points [i - 1];
+  const Point &p1 = m_points [i];
+  end = p1.time;
+  if (m_type == STEP)
+    {
+      f0 = f1 = std::max (p0.factor, m_minFactor);
+      return;
+    }
+
+  // Split the ramp where it crosses the factor floor.
+  double slope = (p1.factor - p0.factor) / (p1.time - p0.time);
+  double raw0 = p0.factor + slope * (t - p0.time);
+  if ((raw0 - m_minFactor) * (p1.factor - m_minFactor) < 0)
+    {
+      end = t + (m_minFactor - raw0) / slope;
+    }
+  f0 = std::max (raw0, m_minFactor);
+  f1 = std::max (p0.factor + slope * (end - p0.time), m_minFactor);
+}
+
+} // namespace ns3
@@ -0,0 +1,111 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+#ifndef DEMAND_PROFILE_H
+#define DEMAND_PROFILE_H
+
+#include <vector>
+#include <ns3/core-module.h>
+
+namespace ns3 {
+
+/**
+ * This class describes a time-varying demand envelope, mapping the simulation
+ * time into a factor that multiplies the nominal application data rate. The
+ * envelope is parsed from a compact string that fits into the slice AppsConfig
+ * syntax (no commas, semicolons, braces, or parenthesis):
+ * \verbatim
+ * pwl:t0:f0/t1:f1/...   Piecewise-linear ramps between (time, factor) points.
+ * step:t0:f0/t1:f1/...  Factor fi held from time ti until the next point.
+ * sin:P:A[:T]           Sinusoid 1 + A * sin (2 * pi * (t - T) / P).
+ * \endverbatim
+ * Times are in seconds. Point lists must be sorted by time. Before the first
+ * point and after the last one, the factor of the nearest point is used.
+ */
+class DemandProfile : public SimpleRefCount<DemandProfile>
+{
+public:
+  /** The envelope type. */
+  enum Type
+  {
+    LINEAR,    //!< Piecewise-linear envelope.
+    STEP,      //!< Piecewise-constant envelope.
+    SINE       //!< Sinusoidal envelope.
+  };
+
+  DemandProfile ();  //!< Default constructor.
+
+  /**
+   * Parse a demand profile string, aborting the simulation on syntax errors.
+   * \param spec The profile string.
+   * \return The demand profile object, or 0 for an empty string.
+   */
+  static Ptr<DemandProfile> Parse (std::string spec);
+
+  /**
+   * Get the rate factor at a given time. The factor is never smaller than the
+   * minimum factor, so applications keep sending at a very low rate instead of
+   * stalling during idle periods.
+   * \param time The simulation time.
+   * \return The rate factor.
+   */
+  double GetFactor (Time time) const;
+
+  /**
+   * Get the time when a packet interval that starts at a given time ends,
+   * integrating the rate factor across the interval. The nominal interval is
+   * the area under the envelope between both times, so a long interval that
+   * starts during an idle period ends soon after the demand rises again.
+   * Sinusoids are integrated over chords of 1/32 of their period.
+   * \param from The interval start time.
+   * \param interval The nominal packet interval.
+   * \return The interval end time.
+   */
+  Time GetNextTime (Time from, Time interval) const;
+
+private:
+  /** A (time, factor) envelope point. */
+  struct Point
+  {
+    double time;    //!< Point time (s).
+    double factor;  //!< Rate factor.
+  };
+
+  /**
+   * Get the envelope piece starting at a given time, along which the floored
+   * rate factor changes linearly.
+   * \param t The piece start time (s).
+   * \param end The piece end time (s), or infinity for the last piece.
+   * \param f0 The factor at the piece start.
+   * \param f1 The factor at the piece end (left limit).
+   */
+  void GetPiece (double t, double &end, double &f0, double &f1) const;
+
+  Type                m_type;       //!< Envelope type.
+  std::vector<Point>  m_points;     //!< LINEAR and STEP points.
+  double              m_period;     //!< SINE period (s).
+  double              m_amplitude;  //!< SINE amplitude.
+  double              m_shift;      //!< SINE time shift (s).
+
+  static const double m_minFactor;  //!< Minimum rate factor.
+};
+
+} // namespace ns3
+#endif /* DEMAND_PROFILE_H */
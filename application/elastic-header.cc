@@ -0,0 +1,108 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+
+#include "elastic-header.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ElasticHeader");
+NS_OBJECT_ENSURE_REGISTERED (ElasticHeader);
+
+ElasticHeader::ElasticHeader ()
+  : m_type (ElasticHeader::DATA),
+  m_seq (0),
+  m_count (0)
+{
+}
+
+ElasticHeader::ElasticHeader (PacketType type, uint32_t seq, uint32_t count)
+  : m_type (type),
+  m_seq (seq),
+  m_count (count)
+{
+}
+
+TypeId
+ElasticHeader::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ElasticHeader")
+    .SetParent<Header> ()
+    .AddConstructor<ElasticHeader> ()
+  ;
+  return tid;
+}
+
+TypeId
+ElasticHeader::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+uint32_t
+ElasticHeader::GetSerializedSize (void) const
+{
+  return 9;
+}
+
+void
+ElasticHeader::Serialize (Buffer::Iterator start) const
+{
+  start.WriteU8 (m_type);
+  start.WriteHtonU32 (m_seq);
+  start.WriteHtonU32 (m_count);
+}
+
+uint32_t
+ElasticHeader::Deserialize (Buffer::Iterator start)
+{
+  m_type = start.ReadU8 ();
+  m_seq = start.ReadNtohU32 ();
+  m_count = start.ReadNtohU32 ();
+  return GetSerializedSize ();
+}
+
+void
+ElasticHeader::Print (std::ostream &os) const
+{
+  os << " Type=" << (m_type == ElasticHeader::DATA ? "data" : "feedback")
+     << " Seq=" << m_seq
+     << " Count=" << m_count;
+}
+
+ElasticHeader::PacketType
+ElasticHeader::GetType (void) const
+{
+  return static_cast<PacketType> (m_type);
+}
+
+uint32_t
+ElasticHeader::GetSeq (void) const
+{
+  return m_seq;
+}
+
+uint32_t
+ElasticHeader::GetCount (void) const
+{
+  return m_count;
+}
+
+} // namespace ns3
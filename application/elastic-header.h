@@ -0,0 +1,97 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+
+#ifndef ELASTIC_HEADER_H
+#define ELASTIC_HEADER_H
+
+#include <ns3/core-module.h>
+#include <ns3/network-module.h>
+
+namespace ns3 {
+
+/**
+ * Header used by UdpPeerApp in elastic mode. Data packets carry their
+ * sequence number, and feedback packets sent back by the receiver carry the
+ * highest sequence number and the number of data packets received so far,
+ * so the sender can estimate the loss ratio between feedbacks.
+ *
+ * \internal
+ * \verbatim
+ * Header has 9 bytes length: 0x 00 00000000 00000000
+ *                              |--|--------|--------|
+ *                               A     B        C
+ *
+ *  8 (A) bits are used for the packet type (data or feedback).
+ * 32 (B) bits are used for the (highest) sequence number.
+ * 32 (C) bits are used for the number of received packets (feedback only).
+ * \endverbatim
+ */
+class ElasticHeader : public Header
+{
+public:
+  /** Elastic packet types. */
+  enum PacketType
+  {
+    DATA     = 0,   //!< Data packet.
+    FEEDBACK = 1    //!< Feedback packet.
+  };
+
+  ElasticHeader ();  //!< Default constructor.
+
+  /**
+   * Complete constructor.
+   * \param type The packet type.
+   * \param seq The (highest) sequence number.
+   * \param count The number of received packets.
+   */
+  ElasticHeader (PacketType type, uint32_t seq, uint32_t count = 0);
+
+  /**
+   * Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  // Inherited from Header
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+  virtual void Print (std::ostream &os) const;
+
+  /**
+   * Private member accessors for header information.
+   * \return The requested information.
+   */
+  //\{
+  PacketType  GetType   (void) const;
+  uint32_t    GetSeq    (void) const;
+  uint32_t    GetCount  (void) const;
+  //\}
+
+private:
+  uint8_t   m_type;   //!< Packet type.
+  uint32_t  m_seq;    //!< Sequence number.
+  uint32_t  m_count;  //!< Received packets.
+};
+
+} // namespace ns3
+#endif /* ELASTIC_HEADER_H */
@@ -0,0 +1,129 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "trace-replay-file.h"
+
+// Binary trace file format.
+#define TRACE_FILE_MAGIC      "SLCTRACE"
+#define TRACE_FILE_VERSION    1
+#define TRACE_FILE_N_SLICES   16
+#define TRACE_FILE_HDR_SIZE   (16 + 16 * TRACE_FILE_N_SLICES)
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TraceReplayFile");
+
+std::map<std::string, Ptr<TraceReplayFile> > TraceReplayFile::m_files;
+
+TraceReplayFile::TraceReplayFile (std::string filename)
+  : m_filename (filename),
+  m_data (0),
+  m_size (0)
+{
+  NS_LOG_FUNCTION (this << filename);
+
+  int fd = open (filename.c_str (), O_RDONLY);
+  NS_ABORT_MSG_IF (fd < 0, "Can't open trace file " << filename);
+
+  struct stat st;
+  NS_ABORT_MSG_IF (fstat (fd, &st) < 0, "Can't stat trace file " << filename);
+  m_size = static_cast<size_t> (st.st_size);
+  NS_ABORT_MSG_IF (m_size < TRACE_FILE_HDR_SIZE,
+                   "Truncated trace file " << filename);
+
+  void *addr = mmap (0, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close (fd);
+  NS_ABORT_MSG_IF (addr == MAP_FAILED, "Can't map trace file " << filename);
+  m_data = static_cast<const uint8_t*> (addr);
+
+  // Check the file header.
+  uint32_t version, nSlices;
+  std::memcpy (&version, m_data + 8, sizeof (version));
+  std::memcpy (&nSlices, m_data + 12, sizeof (nSlices));
+  NS_ABORT_MSG_IF (std::memcmp (m_data, TRACE_FILE_MAGIC, 8) != 0,
+                   "Invalid trace file " << filename);
+  NS_ABORT_MSG_IF (version != TRACE_FILE_VERSION
+                   || nSlices != TRACE_FILE_N_SLICES,
+                   "Unsupported trace file version " << version);
+
+  // Locate the records for each slice.
+  for (int s = 0; s < TRACE_FILE_N_SLICES; s++)
+    {
+      uint64_t offset, count;
+      std::memcpy (&offset, m_data + 16 + 16 * s, sizeof (offset));
+      std::memcpy (&count, m_data + 24 + 16 * s, sizeof (count));
+      NS_ABORT_MSG_IF (count && (offset % 8 || offset < TRACE_FILE_HDR_SIZE
+                                 || offset > m_size
+                                 || count > (m_size - offset) / sizeof (Record)),
+                       "Invalid records for slice " << s << " in " << filename);
+
+      m_records [s] = reinterpret_cast<const Record*> (m_data + offset);
+      m_nRecords [s] = count;
+      NS_LOG_INFO ("Trace file " << filename << " has " << count <<
+                   " records for slice " << s);
+    }
+}
+
+TraceReplayFile::~TraceReplayFile ()
+{
+  NS_LOG_FUNCTION (this);
+
+  munmap (const_cast<uint8_t*> (m_data), m_size);
+}
+
+Ptr<TraceReplayFile>
+TraceReplayFile::Open (std::string filename)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  auto it = m_files.find (filename);
+  if (it == m_files.end ())
+    {
+      it = m_files.insert (
+          std::make_pair (filename, Create<TraceReplayFile> (filename))).first;
+    }
+  return it->second;
+}
+
+const TraceReplayFile::Record*
+TraceReplayFile::GetRecords (uint8_t slice) const
+{
+  NS_LOG_FUNCTION (this << static_cast<uint16_t> (slice));
+
+  NS_ASSERT_MSG (slice <= SLICE_ALL, "Invalid slice ID.");
+  return m_records [slice];
+}
+
+uint64_t
+TraceReplayFile::GetNRecords (uint8_t slice) const
+{
+  NS_LOG_FUNCTION (this << static_cast<uint16_t> (slice));
+
+  NS_ASSERT_MSG (slice <= SLICE_ALL, "Invalid slice ID.");
+  return m_nRecords [slice];
+}
+
+} // namespace ns3
@@ -0,0 +1,101 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+
+#ifndef TRACE_REPLAY_FILE_H
+#define TRACE_REPLAY_FILE_H
+
+#include <map>
+#include <ns3/core-module.h>
+#include "../common.h"
+
+namespace ns3 {
+
+/**
+ * This class gives read-only access to a memory-mapped binary traffic trace
+ * file, with packet times and sizes grouped by network slice. Trace files are
+ * created from pcap or CSV captures by the tools/trace-converter.py script.
+ * Applications replaying the same file share a single memory mapping.
+ *
+ * \internal
+ * The file starts with a 264 bytes header: the 8 bytes magic "SLCTRACE",
+ * the uint32_t format version, the uint32_t number of slice entries (16),
+ * and one {uint64_t offset, uint64_t count} entry for each slice ID, with
+ * the byte offset and the number of its records. Records of each slice are
+ * contiguous and sorted by time, in little-endian byte order:
+ * \verbatim
+ * uint64_t time     Packet time in nanoseconds since the trace start.
+ * uint32_t size     Packet size in bytes.
+ * uint32_t reserved Always zero.
+ * \endverbatim
+ */
+class TraceReplayFile : public SimpleRefCount<TraceReplayFile>
+{
+public:
+  /** A packet record in the trace file. */
+  struct Record
+  {
+    uint64_t time;      //!< Packet time (ns).
+    uint32_t size;      //!< Packet size (bytes).
+    uint32_t reserved;  //!< Reserved.
+  };
+
+  /**
+   * Complete constructor, mapping the file into memory.
+   * \param filename The trace filename.
+   */
+  TraceReplayFile (std::string filename);
+  virtual ~TraceReplayFile ();  //!< Default destructor, unmapping the file.
+
+  /**
+   * Get the shared trace file object for this filename, mapping the file
+   * into memory on the first call.
+   * \param filename The trace filename.
+   * \return The trace file object.
+   */
+  static Ptr<TraceReplayFile> Open (std::string filename);
+
+  /**
+   * Get the records for a network slice.
+   * \param slice The slice ID.
+   * \return The pointer to the first record.
+   */
+  const Record* GetRecords (uint8_t slice) const;
+
+  /**
+   * Get the number of records for a network slice.
+   * \param slice The slice ID.
+   * \return The number of records.
+   */
+  uint64_t GetNRecords (uint8_t slice) const;
+
+private:
+  std::string         m_filename;             //!< Trace filename.
+  const uint8_t      *m_data;                 //!< Mapped file data.
+  size_t              m_size;                 //!< Mapped file size.
+  const Record       *m_records [SLICE_ALL + 1];  //!< Records per slice.
+  uint64_t            m_nRecords [SLICE_ALL + 1]; //!< Record count per slice.
+
+  /** Map of shared trace files by filename. */
+  static std::map<std::string, Ptr<TraceReplayFile> > m_files;
+};
+
+} // namespace ns3
+#endif /* TRACE_REPLAY_FILE_H */
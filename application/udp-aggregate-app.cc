@@ -0,0 +1,249 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+
+#include "udp-aggregate-app.h"
+#include "../metadata/slice-tag.h"
+#include "../statistics/runtime-profiler.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("UdpAggregateApp");
+NS_OBJECT_ENSURE_REGISTERED (UdpAggregateApp);
+
+UdpAggregateApp::UdpAggregateApp ()
+  : m_localSocket (0),
+  m_localPort (0),
+  m_peerAddress (Address ()),
+  m_sendEvent (EventId ())
+{
+  NS_LOG_FUNCTION (this);
+
+  m_expRng = CreateObject<ExponentialRandomVariable> ();
+}
+
+UdpAggregateApp::~UdpAggregateApp ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+UdpAggregateApp::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::UdpAggregateApp")
+    .SetParent<Application> ()
+    .AddConstructor<UdpAggregateApp> ()
+    .AddAttribute ("LocalPort", "Local port.",
+                   UintegerValue (10000),
+                   MakeUintegerAccessor (&UdpAggregateApp::m_localPort),
+                   MakeUintegerChecker<uint16_t> ())
+    .AddAttribute ("PeerAddress", "The peer socket address.",
+                   AddressValue (),
+                   MakeAddressAccessor (&UdpAggregateApp::m_peerAddress),
+                   MakeAddressChecker ())
+    .AddAttribute ("ExpInterval",
+                   "Exponential intervals between packets of each flow.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&UdpAggregateApp::m_expInterval),
+                   MakeBooleanChecker ())
+    .AddAttribute ("TQosType", "Different types of traffic.",
+                   EnumValue (TQosType::ALL),
+                   MakeEnumAccessor (&UdpAggregateApp::m_tQosType),
+                   MakeEnumChecker (TQosType::AF, TQosTypeStr (TQosType::AF),
+                                    TQosType::BE, TQosTypeStr (TQosType::BE),
+                                    TQosType::PRIO, TQosTypeStr (TQosType::PRIO)))
+    .AddAttribute ("SliceId", "Slice identifier.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&UdpAggregateApp::m_sliceId),
+                   MakeUintegerChecker<uint8_t> ())
+
+    .AddTraceSource ("RxPkt", "Trace source for received packets.",
+                     MakeTraceSourceAccessor (&UdpAggregateApp::m_rxTrace),
+                     "ns3::UdpPeerApp::SliceTracedCallback")
+    .AddTraceSource ("TxPkt", "Trace source for transmitted packets.",
+                     MakeTraceSourceAccessor (&UdpAggregateApp::m_txTrace),
+                     "ns3::UdpPeerApp::SliceTracedCallback")
+  ;
+  return tid;
+}
+
+void
+UdpAggregateApp::Configure (const AggregateConfig &config)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_localPort = config.localPort;
+  m_peerAddress = config.peerAddress;
+  m_expInterval = config.expInterval;
+  m_tQosType = config.tQosType;
+  m_sliceId = config.sliceId;
+}
+
+void
+UdpAggregateApp::AddFlow (Time startTime, Time stopTime, Time pktInterval,
+                          uint32_t pktSize)
+{
+  NS_LOG_FUNCTION (this << startTime << stopTime << pktInterval << pktSize);
+
+  NS_ASSERT_MSG (pktInterval.IsStrictlyPositive (), "Invalid packet interval.");
+
+  FlowInfo flow;
+  flow.nextTx = Max (startTime, Simulator::Now ());
+  flow.nextTx += GetNextInterval (pktInterval);
+  flow.stopTime = stopTime;
+  flow.pktInterval = pktInterval;
+  flow.pktSize = pktSize;
+  if (flow.nextTx < flow.stopTime)
+    {
+      m_flows.push (flow);
+    }
+
+  // Reschedule the send event when the new flow is the earliest one.
+  if (m_localSocket)
+    {
+      ScheduleNext ();
+    }
+}
+
+uint32_t
+UdpAggregateApp::GetNFlows (void) const
+{
+  return m_flows.size ();
+}
+
+void
+UdpAggregateApp::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_localSocket = 0;
+  m_expRng = 0;
+  m_flows = FlowQueue_t ();
+  m_sendEvent.Cancel ();
+  Application::DoDispose ();
+}
+
+void
+UdpAggregateApp::StartApplication (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_localSocket == 0)
+    {
+      NS_LOG_INFO ("Opening the UDP socket.");
+      TypeId udpFactory = TypeId::LookupByName ("ns3::UdpSocketFactory");
+      m_localSocket = Socket::CreateSocket (GetNode (), udpFactory);
+      m_localSocket->Bind (InetSocketAddress (Ipv4Address::GetAny (), m_localPort));
+      m_localSocket->Connect (InetSocketAddress::ConvertFrom (m_peerAddress));
+      m_localSocket->SetRecvCallback (
+        MakeCallback (&UdpAggregateApp::ReadPacket, this));
+    }
+  ScheduleNext ();
+}
+
+void
+UdpAggregateApp::StopApplication ()
+{
+  NS_LOG_FUNCTION (this);
+
+  // Cancel any pending send event and close the socket.
+  m_sendEvent.Cancel ();
+  if (m_localSocket != 0)
+    {
+      m_localSocket->Close ();
+      m_localSocket->Dispose ();
+      m_localSocket = 0;
+    }
+}
+
+void
+UdpAggregateApp::ReadPacket (Ptr<Socket> socket)
+{
+  NS_LOG_FUNCTION (this << socket);
+
+  Ptr<Packet> packet = socket->Recv ();
+  m_rxTrace (packet, m_sliceId, m_tQosType);
+  NS_LOG_DEBUG ("RX packet with " << packet->GetSize () << " bytes.");
+}
+
+void
+UdpAggregateApp::SendPackets (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  RuntimeProfiler::Scope profScope (RuntimeProfiler::APP_SEND);
+
+  // Send one packet for each flow due at this time.
+  Time now = Simulator::Now ();
+  while (!m_flows.empty () && m_flows.top ().nextTx <= now)
+    {
+      FlowInfo flow = m_flows.top ();
+      m_flows.pop ();
+
+      Ptr<Packet> packet = Create<Packet> (flow.pktSize);
+      SliceTag tag (m_sliceId, m_tQosType);
+      packet->AddPacketTag (tag);
+      m_txTrace (packet, m_sliceId, m_tQosType);
+
+      int bytes = m_localSocket->Send (packet);
+      if (bytes == static_cast<int> (packet->GetSize ()))
+        {
+          NS_LOG_DEBUG ("TX packet with " << bytes << " bytes.");
+        }
+      else
+        {
+          NS_LOG_ERROR ("TX error.");
+        }
+
+      // Keep the flow while it has packets to send.
+      flow.nextTx = now + GetNextInterval (flow.pktInterval);
+      if (flow.nextTx < flow.stopTime)
+        {
+          m_flows.push (flow);
+        }
+    }
+  ScheduleNext ();
+}
+
+void
+UdpAggregateApp::ScheduleNext (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_sendEvent.Cancel ();
+  if (!m_flows.empty ())
+    {
+      Time sendTime = Max (m_flows.top ().nextTx - Simulator::Now (), Time (0));
+      m_sendEvent = Simulator::Schedule (
+          sendTime, &UdpAggregateApp::SendPackets, this);
+    }
+}
+
+Time
+UdpAggregateApp::GetNextInterval (Time pktInterval)
+{
+  if (m_expInterval)
+    {
+      return Seconds (m_expRng->GetValue (pktInterval.GetSeconds (), 0));
+    }
+  return pktInterval;
+}
+
+} // namespace ns3
@@ -0,0 +1,165 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+
+#ifndef UDP_AGGREGATE_APP
+#define UDP_AGGREGATE_APP
+
+#include <queue>
+#include <ns3/core-module.h>
+#include <ns3/network-module.h>
+#include <ns3/internet-module.h>
+#include "../common.h"
+
+namespace ns3 {
+
+/**
+ * This is an aggregated UDP peer application, sending and receiving the
+ * superposition of many constant bit rate (or exponential interval) traffic
+ * flows from a single socket. Instead of one UdpPeerApp pair and one send
+ * event chain for each flow, this application keeps all its flows in a
+ * priority queue ordered by the next transmission time, with a single
+ * pending send event for the earliest flow. Flows start and stop according
+ * to their own start and stop times, with no additional events.
+ */
+class UdpAggregateApp : public Application
+{
+public:
+  UdpAggregateApp ();           //!< Default constructor.
+  virtual ~UdpAggregateApp ();  //!< Dummy destructor, see DoDispose.
+
+  /**
+   * Get the type ID.
+   * \return the object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Application configuration for the UdpPeerHelper fast install path. */
+  struct AggregateConfig
+  {
+    uint16_t  localPort;    //!< Local port.
+    Address   peerAddress;  //!< Peer address.
+    bool      expInterval;  //!< Exponential intervals.
+    TQosType  tQosType;     //!< Traffic type.
+    uint8_t   sliceId;      //!< Slice Id.
+  };
+
+  /**
+   * Configure this application directly, skipping the attribute system.
+   * \param config The application configuration.
+   */
+  void Configure (const AggregateConfig &config);
+
+  /**
+   * Add a new traffic flow to this application. The first packet of this
+   * flow is sent one packet interval after the start time.
+   * \param startTime The flow start time.
+   * \param stopTime The flow stop time.
+   * \param pktInterval The (mean) interval between packets.
+   * \param pktSize The packet size [bytes].
+   */
+  void AddFlow (Time startTime, Time stopTime, Time pktInterval,
+                uint32_t pktSize);
+
+  /**
+   * Get the number of flows not finished yet.
+   * \return The number of flows.
+   */
+  uint32_t GetNFlows (void) const;
+
+protected:
+  /** Destructor implementation */
+  virtual void DoDispose (void);
+
+private:
+  // Inherited from Application.
+  virtual void StartApplication (void);
+  virtual void StopApplication (void);
+
+  /**
+   * Socket receive callback.
+   * \param socket Socket with data available to be read.
+   */
+  void ReadPacket (Ptr<Socket> socket);
+
+  /**
+   * Handle packet transmissions for all flows due at this time.
+   */
+  void SendPackets (void);
+
+  /**
+   * Schedule the send event for the earliest flow.
+   */
+  void ScheduleNext (void);
+
+  /**
+   * Get the interval until the next packet of a flow.
+   * \param pktInterval The mean interval between packets.
+   * \return The interval until the next packet.
+   */
+  Time GetNextInterval (Time pktInterval);
+
+  /** Metadata associated to a traffic flow. */
+  struct FlowInfo
+  {
+    Time      nextTx;       //!< Next transmission time.
+    Time      stopTime;     //!< Flow stop time.
+    Time      pktInterval;  //!< Mean interval between packets.
+    uint32_t  pktSize;      //!< Packet size.
+  };
+
+  /** Order flows by the earliest next transmission time. */
+  struct FlowCompare
+  {
+    /**
+     * Compare two flows.
+     * \param a The first flow.
+     * \param b The second flow.
+     * \return True if the first flow transmits after the second one.
+     */
+    bool operator () (const FlowInfo &a, const FlowInfo &b) const
+    {
+      return a.nextTx > b.nextTx;
+    }
+  };
+
+  /** Priority queue of traffic flows. */
+  typedef std::priority_queue<FlowInfo, std::vector<FlowInfo>, FlowCompare>
+    FlowQueue_t;
+
+  /** Trace source fired when a packet arrives at this application. */
+  TracedCallback<Ptr<const Packet>, uint8_t, TQosType> m_rxTrace;
+
+  /** Trace source fired when a packet leaves this application. */
+  TracedCallback<Ptr<const Packet>, uint8_t, TQosType> m_txTrace;
+
+  Ptr<Socket>                 m_localSocket;    //!< Local socket.
+  uint16_t                    m_localPort;      //!< Local port.
+  Address                     m_peerAddress;    //!< Peer address.
+  bool                        m_expInterval;    //!< Exponential intervals.
+  Ptr<ExponentialRandomVariable> m_expRng;      //!< Packet interval time.
+  uint8_t                     m_sliceId;        //!< Slice Id.
+  TQosType                    m_tQosType;       //!< Traffic type.
+  FlowQueue_t                 m_flows;          //!< Traffic flows.
+  EventId                     m_sendEvent;      //!< SendPackets event.
+};
+
+} // namespace ns3
+#endif /* UDP_AGGREGATE_APP */
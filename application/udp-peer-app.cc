@@ -20,6 +20,7 @@
 
 #include "udp-peer-app.h"
 #include "../metadata/slice-tag.h"
+#include "../statistics/runtime-profiler.h"
 
 namespace ns3 {
 
@@ -32,7 +33,19 @@ UdpPeerApp::UdpPeerApp ()
   m_peerAddress (Address ()),
   m_pktInterRng (0),
   m_pktSizeRng (0),
-  m_sendEvent (EventId ())
+  m_fixedPktSize (0),
+  m_fixedPktInterval (Time (0)),
+  m_sendEvent (EventId ()),
+  m_burstSize (1),
+  m_traceFile (0),
+  m_traceIdx (0),
+  m_elasticPktSize (0),
+  m_txSeq (0),
+  m_rxHighSeq (0),
+  m_rxCount (0),
+  m_rxNew (false),
+  m_fbLastSeq (0),
+  m_fbLastCount (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -57,15 +70,68 @@ UdpPeerApp::GetTypeId (void)
                    MakeAddressAccessor (&UdpPeerApp::m_peerAddress),
                    MakeAddressChecker ())
     .AddAttribute ("PktInterval",
-                   "A random variable for the interval between packets [s].",
-                   StringValue ("ns3::ConstantRandomVariable[Constant=1]"),
+                   "A random variable for the interval between packets [s] "
+                   "(null for a constant 1 s interval).",
+                   PointerValue (),
                    MakePointerAccessor (&UdpPeerApp::m_pktInterRng),
                    MakePointerChecker <RandomVariableStream> ())
     .AddAttribute ("PktSize",
-                   "A random variable for the packet size [bytes].",
-                   StringValue ("ns3::ConstantRandomVariable[Constant=1024]"),
+                   "A random variable for the packet size [bytes] "
+                   "(null for a constant 1024 bytes size).",
+                   PointerValue (),
                    MakePointerAccessor (&UdpPeerApp::m_pktSizeRng),
                    MakePointerChecker <RandomVariableStream> ())
+    .AddAttribute ("BurstSize",
+                   "Number of packets sent per send event. The packets leave "
+                   "back-to-back at the nominal time of the first one, and "
+                   "the next burst starts after the nominal time of the last "
+                   "one, so the offered load is the same.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&UdpPeerApp::m_burstSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("TraceFile",
+                   "Binary trace file to replay packet times and sizes for "
+                   "this app slice (empty to use PktInterval and PktSize).",
+                   StringValue (""),
+                   MakeStringAccessor (&UdpPeerApp::m_traceFilename),
+                   MakeStringChecker ())
+    .AddAttribute ("TraceOffset", "The first trace record for this app.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&UdpPeerApp::m_traceOffset),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("TraceStride",
+                   "The stride between trace records for this app, so "
+                   "apps in the same slice can split the trace records.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&UdpPeerApp::m_traceStride),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("Elastic",
+                   "Adapt the data rate to the loss ratio reported by the "
+                   "peer (additive increase, multiplicative decrease). The "
+                   "initial rate comes from PktInterval and PktSize.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&UdpPeerApp::m_elastic),
+                   MakeBooleanChecker ())
+    .AddAttribute ("FeedbackInterval",
+                   "The interval between feedbacks in elastic mode.",
+                   TimeValue (MilliSeconds (100)),
+                   MakeTimeAccessor (&UdpPeerApp::m_fbInterval),
+                   MakeTimeChecker (MilliSeconds (1)))
+    .AddAttribute ("LossThreshold",
+                   "The loss ratio above which the elastic rate decreases.",
+                   DoubleValue (0.01),
+                   MakeDoubleAccessor (&UdpPeerApp::m_lossThreshold),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("AddRate",
+                   "The elastic rate additive increase for each feedback.",
+                   DataRateValue (DataRate ("64kbps")),
+                   MakeDataRateAccessor (&UdpPeerApp::m_addRate),
+                   MakeDataRateChecker ())
+    .AddAttribute ("MultDecrease",
+                   "The elastic rate multiplicative decrease factor.",
+                   DoubleValue (0.5),
+                   MakeDoubleAccessor (&UdpPeerApp::m_multDecrease),
+                   MakeDoubleChecker<double> (0.0, 1.0))
     .AddAttribute ("QosType", "Traffic QoS indicator.",
                    EnumValue (QosType::NON),
                    MakeEnumAccessor (&UdpPeerApp::m_qosType),
@@ -84,10 +150,10 @@ UdpPeerApp::GetTypeId (void)
 
     .AddTraceSource ("RxPkt", "Trace source for received packets.",
                      MakeTraceSourceAccessor (&UdpPeerApp::m_rxTrace),
-                     "ns3::Packet::TracedCallback")
+                     "ns3::UdpPeerApp::SliceTracedCallback")
     .AddTraceSource ("TxPkt", "Trace source for transmitted packets.",
                      MakeTraceSourceAccessor (&UdpPeerApp::m_txTrace),
-                     "ns3::Packet::TracedCallback")
+                     "ns3::UdpPeerApp::SliceTracedCallback")
   ;
   return tid;
 }
@@ -113,8 +179,28 @@ UdpPeerApp::StartTraffic (void)
 
   // Schedule the first packet transmission.
   m_sendEvent.Cancel ();
-  Time sendTime = Seconds (std::abs (m_pktInterRng->GetValue ()));
-  m_sendEvent = Simulator::Schedule (sendTime, &UdpPeerApp::SendPacket, this);
+  if (!m_traceFilename.empty ())
+    {
+      // Replay trace records relative to the traffic start time.
+      m_traceFile = TraceReplayFile::Open (m_traceFilename);
+      m_traceIdx = m_traceOffset;
+      m_traceStart = Simulator::Now ();
+      ScheduleTraceRecord ();
+    }
+  else
+    {
+      if (m_elastic)
+        {
+          // Fix the packet size and start at the configured data rate.
+          m_elasticPktSize = std::max (GetNextPktSize (),
+                                       ElasticHeader ().GetSerializedSize ());
+          double interval = GetNextPktInterval ().GetSeconds ();
+          NS_ASSERT_MSG (interval > 0, "Invalid packet interval.");
+          m_elasticRate = DataRate (m_elasticPktSize * 8 / interval);
+        }
+      m_burstEnd = Simulator::Now ();
+      ScheduleBurst ();
+    }
 }
 
 void
@@ -125,15 +211,37 @@ UdpPeerApp::StopTraffic (void)
   StopApplication ();
 }
 
+void
+UdpPeerApp::Configure (const PeerConfig &config)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_localPort = config.localPort;
+  m_peerAddress = config.peerAddress;
+  m_qosType = config.qosType;
+  m_tQosType = config.tQosType;
+  m_sliceId = config.sliceId;
+  m_elastic = config.elastic;
+  m_fixedPktSize = config.pktSize;
+  m_fixedPktInterval = config.pktInterval;
+  m_profile = config.profile;
+  m_traceFilename = config.traceFile;
+  m_traceOffset = config.traceOffset;
+  m_traceStride = config.traceStride;
+}
+
 void
 UdpPeerApp::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
 
   m_localSocket = 0;
+  m_traceFile = 0;
+  m_profile = 0;
   m_pktInterRng = 0;
   m_pktSizeRng = 0;
   m_sendEvent.Cancel ();
+  m_fbEvent.Cancel ();
   Application::DoDispose ();
 }
 
@@ -162,6 +270,7 @@ UdpPeerApp::StopApplication ()
 
   // Cancel any pending send event and close the socket.
   m_sendEvent.Cancel ();
+  m_fbEvent.Cancel ();
   if (m_localSocket != 0)
     {
       m_localSocket->Close ();
@@ -176,7 +285,27 @@ UdpPeerApp::ReadPacket (Ptr<Socket> socket)
   NS_LOG_FUNCTION (this << socket);
 
   Ptr<Packet> packet = socket->Recv ();
-  m_rxTrace (packet);
+  if (m_elastic)
+    {
+      ElasticHeader header;
+      packet->PeekHeader (header);
+      if (header.GetType () == ElasticHeader::FEEDBACK)
+        {
+          ProcessFeedback (header);
+          return;
+        }
+
+      // Report received data packets in the next feedback.
+      m_rxHighSeq = std::max (m_rxHighSeq, header.GetSeq ());
+      m_rxCount++;
+      m_rxNew = true;
+      if (!m_fbEvent.IsRunning ())
+        {
+          m_fbEvent = Simulator::Schedule (
+              m_fbInterval, &UdpPeerApp::SendFeedback, this);
+        }
+    }
+  m_rxTrace (packet, m_sliceId, m_tQosType);
   NS_LOG_DEBUG ("RX packet with " << packet->GetSize () << " bytes.");
 }
 
@@ -185,12 +314,91 @@ UdpPeerApp::SendPacket ()
 {
   NS_LOG_FUNCTION (this);
 
-  Ptr<Packet> packet = Create<Packet> (m_pktSizeRng->GetInteger ());
-  SliceTag tag (m_sliceId, m_qosType, m_tQosType);
-  // std::cout << "Slice id do pacote " << m_sliceId << std::endl;
+  RuntimeProfiler::Scope profScope (RuntimeProfiler::APP_SEND);
+
+  // Send all packets in this burst, tagged with the actual send time.
+  for (uint32_t i = 0; i < m_burstSize; i++)
+    {
+      Ptr<Packet> packet;
+      if (m_elastic)
+        {
+          ElasticHeader header (ElasticHeader::DATA, ++m_txSeq);
+          packet = Create<Packet> (
+              m_elasticPktSize - header.GetSerializedSize ());
+          packet->AddHeader (header);
+        }
+      else
+        {
+          packet = Create<Packet> (GetNextPktSize ());
+        }
+      SliceTag tag (m_sliceId, m_tQosType);
+      packet->AddPacketTag (tag);
+      m_txTrace (packet, m_sliceId, m_tQosType);
+
+      int bytes = m_localSocket->Send (packet);
+      if (bytes == static_cast<int> (packet->GetSize ()))
+        {
+          NS_LOG_DEBUG ("TX packet with " << bytes << " bytes.");
+        }
+      else
+        {
+          NS_LOG_ERROR ("TX error.");
+        }
+    }
+
+  // Schedule the next packet transmission.
+  ScheduleBurst ();
+}
+
+void
+UdpPeerApp::ScheduleBurst (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // The burst leaves at the nominal time of its first packet, so packets are
+  // never delayed, and the next burst starts after the nominal time of the
+  // last one.
+  Time pktTime = m_burstEnd;
+  Time sendTime;
+  for (uint32_t i = 0; i < m_burstSize; i++)
+    {
+      if (m_elastic)
+        {
+          pktTime += m_elasticRate.CalculateBytesTxTime (m_elasticPktSize);
+        }
+      else if (m_profile)
+        {
+          // Stretch the interval along the demand envelope.
+          pktTime = m_profile->GetNextTime (pktTime, GetNextPktInterval ());
+        }
+      else
+        {
+          pktTime += GetNextPktInterval ();
+        }
+      if (i == 0)
+        {
+          sendTime = pktTime;
+        }
+    }
+  m_burstEnd = pktTime;
+  m_sendEvent = Simulator::Schedule (sendTime - Simulator::Now (),
+                                     &UdpPeerApp::SendPacket, this);
+}
+
+void
+UdpPeerApp::SendTracePacket (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  RuntimeProfiler::Scope profScope (RuntimeProfiler::APP_SEND);
+
+  const TraceReplayFile::Record &record =
+    m_traceFile->GetRecords (m_sliceId) [m_traceIdx];
+  Ptr<Packet> packet = Create<Packet> (record.size);
+  SliceTag tag (m_sliceId, m_tQosType);
   packet->AddPacketTag (tag);
-  m_txTrace (packet);
-  
+  m_txTrace (packet, m_sliceId, m_tQosType);
+
   int bytes = m_localSocket->Send (packet);
   if (bytes == static_cast<int> (packet->GetSize ()))
     {
@@ -201,9 +409,118 @@ UdpPeerApp::SendPacket ()
       NS_LOG_ERROR ("TX error.");
     }
 
-  // Schedule the next packet transmission.
-  Time sendTime = Seconds (std::abs (m_pktInterRng->GetValue ()));
-  m_sendEvent = Simulator::Schedule (sendTime, &UdpPeerApp::SendPacket, this);
+  // Schedule the next trace record.
+  m_traceIdx += m_traceStride;
+  ScheduleTraceRecord ();
+}
+
+void
+UdpPeerApp::ScheduleTraceRecord (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_traceIdx >= m_traceFile->GetNRecords (m_sliceId))
+    {
+      NS_LOG_INFO ("End of trace records for slice " <<
+                   static_cast<uint16_t> (m_sliceId));
+      return;
+    }
+
+  const TraceReplayFile::Record &record =
+    m_traceFile->GetRecords (m_sliceId) [m_traceIdx];
+  Time sendTime = m_traceStart + NanoSeconds (record.time) - Simulator::Now ();
+  m_sendEvent = Simulator::Schedule (Max (sendTime, Time (0)),
+                                     &UdpPeerApp::SendTracePacket, this);
+}
+
+uint32_t
+UdpPeerApp::GetNextPktSize (void)
+{
+  if (m_fixedPktSize)
+    {
+      return m_fixedPktSize;
+    }
+  if (!m_pktSizeRng)
+    {
+      // Create the default random variable only when it is used.
+      m_pktSizeRng = CreateObjectWithAttributes<ConstantRandomVariable> (
+          "Constant", DoubleValue (1024));
+    }
+  return m_pktSizeRng->GetInteger ();
+}
+
+Time
+UdpPeerApp::GetNextPktInterval (void)
+{
+  if (!m_fixedPktInterval.IsZero ())
+    {
+      return m_fixedPktInterval;
+    }
+  if (!m_pktInterRng)
+    {
+      // Create the default random variable only when it is used.
+      m_pktInterRng = CreateObjectWithAttributes<ConstantRandomVariable> (
+          "Constant", DoubleValue (1));
+    }
+  return Seconds (std::abs (m_pktInterRng->GetValue ()));
+}
+
+void
+UdpPeerApp::SendFeedback (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // Stop sending feedbacks when data packets stop arriving.
+  if (!m_localSocket || !m_rxNew)
+    {
+      return;
+    }
+
+  // Tag feedbacks too, so links account them to the slice.
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (
+    ElasticHeader (ElasticHeader::FEEDBACK, m_rxHighSeq, m_rxCount));
+  SliceTag tag (m_sliceId, m_tQosType);
+  packet->AddPacketTag (tag);
+  m_localSocket->Send (packet);
+  m_rxNew = false;
+
+  m_fbEvent = Simulator::Schedule (
+      m_fbInterval, &UdpPeerApp::SendFeedback, this);
+}
+
+void
+UdpPeerApp::ProcessFeedback (const ElasticHeader &header)
+{
+  NS_LOG_FUNCTION (this << header.GetSeq () << header.GetCount ());
+
+  // Ignore feedbacks with no new data packets (or out of order).
+  if (header.GetSeq () <= m_fbLastSeq)
+    {
+      return;
+    }
+
+  uint32_t expected = header.GetSeq () - m_fbLastSeq;
+  uint32_t received = std::min (header.GetCount () - m_fbLastCount, expected);
+  double lossRatio = 1.0 - static_cast<double> (received) / expected;
+  m_fbLastSeq = header.GetSeq ();
+  m_fbLastCount = header.GetCount ();
+
+  // The rate never drops below one packet per second.
+  uint64_t minBitRate = m_elasticPktSize * 8;
+  if (lossRatio > m_lossThreshold)
+    {
+      m_elasticRate = DataRate (std::max (
+          static_cast<uint64_t> (m_elasticRate.GetBitRate () * m_multDecrease),
+          minBitRate));
+    }
+  else
+    {
+      m_elasticRate = DataRate (
+          m_elasticRate.GetBitRate () + m_addRate.GetBitRate ());
+    }
+  NS_LOG_DEBUG ("Loss ratio " << lossRatio << " with new elastic rate " <<
+                Bps2Kbps (m_elasticRate));
 }
 
 } // namespace ns3
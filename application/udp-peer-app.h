@@ -25,6 +25,9 @@
 #include <ns3/network-module.h>
 #include <ns3/internet-module.h>
 #include "../common.h"
+#include "demand-profile.h"
+#include "elastic-header.h"
+#include "trace-replay-file.h"
 
 namespace ns3 {
 
@@ -50,10 +53,43 @@ public:
   /** Stop the application traffic. */
   void StopTraffic (void);
 
+  /** Application configuration for the UdpPeerHelper fast install path. */
+  struct PeerConfig
+  {
+    uint16_t  localPort;    //!< Local port.
+    Address   peerAddress;  //!< Peer address.
+    QosType   qosType;      //!< Traffic QoS type.
+    TQosType  tQosType;     //!< Traffic type.
+    uint8_t   sliceId;      //!< Slice Id.
+    bool      elastic;      //!< Elastic mode.
+    uint32_t  pktSize;      //!< Fixed packet size (0 to use PktSize).
+    Time      pktInterval;  //!< Fixed packet interval (0 to use PktInterval).
+    Ptr<const DemandProfile> profile; //!< Demand profile (may be 0).
+    std::string traceFile;  //!< Trace file to replay (empty for none).
+    uint32_t  traceOffset;  //!< First trace record.
+    uint32_t  traceStride;  //!< Trace record stride.
+  };
+
+  /**
+   * Configure this application directly, skipping the attribute system.
+   * \param config The application configuration.
+   */
+  void Configure (const PeerConfig &config);
+
 
   TQosType GetTQosType(void);
   uint8_t GetSliceId(void);
 
+  /**
+   * TracedCallback signature for packets of this application, carrying the
+   * slice index and traffic type so sinks can skip the slice tag lookup.
+   * \param packet The packet.
+   * \param sliceId The slice ID.
+   * \param ttype The traffic type.
+   */
+  typedef void (*SliceTracedCallback)(Ptr<const Packet> packet,
+                                      uint8_t sliceId, TQosType ttype);
+
 protected:
   /** Destructor implementation */
   virtual void DoDispose (void);
@@ -70,24 +106,93 @@ private:
   void ReadPacket (Ptr<Socket> socket);
 
   /**
-   * Handle a packet transmission.
+   * Handle the transmission of a burst of packets.
    */
   void SendPacket (void);
 
+  /**
+   * Draw the packet times for the next burst and schedule its transmission
+   * at the time of the first packet in the burst.
+   */
+  void ScheduleBurst (void);
+
+  /**
+   * Handle a packet transmission in trace replay mode.
+   */
+  void SendTracePacket (void);
+
+  /**
+   * Schedule the transmission of the next trace record for this app.
+   */
+  void ScheduleTraceRecord (void);
+
+  /**
+   * Get the size of the next packet, from the fixed packet size or from the
+   * PktSize random variable.
+   * \return The packet size [bytes].
+   */
+  uint32_t GetNextPktSize (void);
+
+  /**
+   * Get the interval until the next packet, from the fixed packet interval
+   * or from the PktInterval random variable.
+   * \return The packet interval.
+   */
+  Time GetNextPktInterval (void);
+
+  /**
+   * Send a feedback packet to the peer in elastic mode, reporting the
+   * received data packets, and schedule the next feedback while data
+   * packets keep arriving.
+   */
+  void SendFeedback (void);
+
+  /**
+   * Adjust the elastic data rate with additive increase and multiplicative
+   * decrease, depending on the loss ratio reported by the peer.
+   * \param header The feedback header.
+   */
+  void ProcessFeedback (const ElasticHeader &header);
+
   /** Trace source fired when a packet arrives at this application. */
-  TracedCallback<Ptr<const Packet> > m_rxTrace;
+  TracedCallback<Ptr<const Packet>, uint8_t, TQosType> m_rxTrace;
 
   /** Trace source fired when a packet leaves this application. */
-  TracedCallback<Ptr<const Packet> > m_txTrace;
+  TracedCallback<Ptr<const Packet>, uint8_t, TQosType> m_txTrace;
 
   Ptr<Socket>                 m_localSocket;    //!< Local socket.
   uint16_t                    m_localPort;      //!< Local port.
   Address                     m_peerAddress;    //!< Peer address.
   Ptr<RandomVariableStream>   m_pktInterRng;    //!< Packet interval time.
   Ptr<RandomVariableStream>   m_pktSizeRng;     //!< Packet size.
+  uint32_t                    m_fixedPktSize;   //!< Fixed packet size.
+  Time                        m_fixedPktInterval; //!< Fixed packet interval.
+  Ptr<const DemandProfile>    m_profile;        //!< Demand profile.
   uint8_t                     m_sliceId;        //!< Slice Id.
   QosType                     m_qosType;        //!< Traffic QoS type.
   EventId                     m_sendEvent;      //!< SendPacket event.
+  uint32_t                    m_burstSize;      //!< Packets per send event.
+  Time                        m_burstEnd;       //!< Last packet time in burst.
+  std::string                 m_traceFilename;  //!< Trace filename.
+  uint32_t                    m_traceOffset;    //!< First trace record.
+  uint32_t                    m_traceStride;    //!< Trace record stride.
+  Ptr<TraceReplayFile>        m_traceFile;      //!< Trace file.
+  uint64_t                    m_traceIdx;       //!< Next trace record.
+  Time                        m_traceStart;     //!< Trace replay start time.
+  bool                        m_elastic;        //!< Elastic mode.
+  Time                        m_fbInterval;     //!< Feedback interval.
+  double                      m_lossThreshold;  //!< Loss ratio threshold.
+  DataRate                    m_addRate;        //!< Additive increase.
+  double                      m_multDecrease;   //!< Multiplicative decrease.
+  DataRate                    m_elasticRate;    //!< Elastic data rate.
+  uint32_t                    m_elasticPktSize; //!< Elastic packet size.
+  uint32_t                    m_txSeq;          //!< Last TX sequence number.
+  uint32_t                    m_rxHighSeq;      //!< Highest RX sequence.
+  uint32_t                    m_rxCount;        //!< RX data packets.
+  bool                        m_rxNew;          //!< RX since last feedback.
+  uint32_t                    m_fbLastSeq;      //!< Last feedback sequence.
+  uint32_t                    m_fbLastCount;    //!< Last feedback count.
+  EventId                     m_fbEvent;        //!< SendFeedback event.
 
   TQosType m_tQosType;
 };
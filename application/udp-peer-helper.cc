@@ -25,8 +25,9 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("UdpPeerHelper");
 NS_OBJECT_ENSURE_REGISTERED (UdpPeerHelper);
 
-// Initial port number
-uint16_t UdpPeerHelper::m_port = 10000;
+// Initial port number on each node
+const uint16_t UdpPeerHelper::m_initPort = 10000;
+std::map<uint32_t, uint16_t> UdpPeerHelper::m_nodePorts;
 
 UdpPeerHelper::UdpPeerHelper ()
   : m_startTime (Seconds (0))
@@ -94,8 +95,38 @@ UdpPeerHelper::GetTypeId (void)
                    MakeEnumChecker (TQosType::AF, TQosTypeStr (TQosType::AF),
                                     TQosType::BE, TQosTypeStr (TQosType::BE),
                                     TQosType::PRIO, TQosTypeStr (TQosType::PRIO)))
+    .AddAttribute ("Aggregate",
+                   "Install a single aggregated app for each pair of nodes, "
+                   "sending the superposition of all app flows.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&UdpPeerHelper::m_aggregate),
+                   MakeBooleanChecker ())
+    .AddAttribute ("ExpInterval",
+                   "Exponential intervals between packets of aggregated flows.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&UdpPeerHelper::m_expInterval),
+                   MakeBooleanChecker ())
+    .AddAttribute ("Elastic",
+                   "Install elastic apps, adapting the data rate to the "
+                   "loss reported by the peer app.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&UdpPeerHelper::m_elastic),
+                   MakeBooleanChecker ())
+    .AddAttribute ("TraceFile",
+                   "Binary trace file replayed by the slice apps, split among "
+                   "them, from the 1st to the 2nd node only (empty to use "
+                   "the DataRate random variable).",
+                   StringValue (""),
+                   MakeStringAccessor (&UdpPeerHelper::m_traceFile),
+                   MakeStringChecker ())
+    .AddAttribute ("DemandProfile",
+                   "Rate envelope applied over time to the apps data rate, "
+                   "as pwl:t:f/..., step:t:f/..., or sin:period:amp[:shift] "
+                   "(empty for constant demand).",
+                   StringValue (""),
+                   MakeStringAccessor (&UdpPeerHelper::m_profileSpec),
+                   MakeStringChecker ())
 
- 
   ;
   return tid;
 }
@@ -151,6 +182,17 @@ UdpPeerHelper::Install (
                  && nodes1st.GetN () == addr1st.GetN (),
                  "Inconsistent number of nodes or interfaces.");
 
+  NS_ABORT_MSG_IF (m_aggregate && !m_traceFile.empty (),
+                   "Trace replay is not supported by aggregated apps.");
+  NS_ABORT_MSG_IF (m_aggregate && m_elastic,
+                   "Elastic traffic is not supported by aggregated apps.");
+  NS_ABORT_MSG_IF (!m_profileSpec.empty () && (m_aggregate || m_elastic
+                                                 || !m_traceFile.empty ()),
+                   "Demand profiles only apply to non-elastic peer apps.");
+
+  // Parse the demand profile once, sharing it among all apps.
+  m_profile = DemandProfile::Parse (m_profileSpec);
+
   // For each pair of nodes, install m_numApps applications.
   
   Ptr<UniformRandomVariable> randomVar = CreateObject<UniformRandomVariable>();
@@ -167,6 +209,18 @@ UdpPeerHelper::Install (
       startTimeSplit = Seconds (250);      
       startTimeSplit2 = Seconds (500);	
 
+      // In aggregate mode, all flows share a single pair of applications.
+      ApplicationContainer aggApps;
+      if (m_aggregate)
+        {
+          aggApps = InstallAggregateApp (nodes1st.Get (i), nodes2nd.Get (i),
+                                         addr1st.GetAddress (i),
+                                         addr2nd.GetAddress (i),
+                                         GetNextPortNo (nodes1st.Get (i),
+                                                        nodes2nd.Get (i)),
+                                         sliceId);
+        }
+
       for (uint16_t j = 0; j < m_numApps; j++)
         {
 	
@@ -195,35 +249,58 @@ UdpPeerHelper::Install (
           
           Time lengthTime = Seconds (std::abs (m_lengthRng->GetValue ()));
 
-          ApplicationContainer apps;
-          apps = InstallApp (nodes1st.Get (i), nodes2nd.Get (i),
-                            addr1st.GetAddress (i), addr2nd.GetAddress (i),
-                            GetNextPortNo (), m_DSCP, startCurrent, lengthTime, sliceId);
+          if (!m_traceFile.empty ())
+            {
+              // In trace replay mode, all apps start together and split the
+              // slice trace records among them, so the aggregated traffic
+              // follows the trace timing until the end of the simulation.
+              // The trace holds a single direction, so only the 1st app
+              // replays it, even in full-duplex mode.
+              InstallApp (nodes1st.Get (i), nodes2nd.Get (i),
+                          addr1st.GetAddress (i), addr2nd.GetAddress (i),
+                          GetNextPortNo (nodes1st.Get (i), nodes2nd.Get (i)),
+                          m_DSCP, m_startOff, Time::Max () - m_startOff,
+                          sliceId, 0, Time (0), i * m_numApps + j,
+                          nodes1st.GetN () * m_numApps);
+              continue;
+            }
+
+          if (m_aggregate)
+            {
+              // Fix the packet size at 1024 bytes and compute the packet
+              // interval to match the desired data rate.
+              DataRate cbr (std::abs (m_rateRng->GetValue () * 1000));
+              uint32_t pktSize = 1024;
+              Time pktInterval = cbr.CalculateBytesTxTime (pktSize);
+              Time stopTime = startCurrent + lengthTime;
+
+              DynamicCast<UdpAggregateApp> (aggApps.Get (0))->AddFlow (
+                startCurrent, stopTime, pktInterval, pktSize);
+              if (m_fullDuplex)
+                {
+                  DynamicCast<UdpAggregateApp> (aggApps.Get (1))->AddFlow (
+                    startCurrent, stopTime, pktInterval, pktSize);
+                }
 
+              NS_LOG_INFO ("Flow " << j << " at host " << i <<
+                           " will start at " << startCurrent.GetSeconds () <<
+                           " with data rate of " << Bps2Kbps (cbr) <<
+                           " and traffic length of " << lengthTime.GetSeconds ());
+              continue;
+            }
 
           // Fix the packet size at 1024 bytes and compute the packet interval
           // to match the desired data rate.
           DataRate cbr (std::abs (m_rateRng->GetValue () * 1000));
-          double pktSize = 1024;
-          double pktInterval = (pktSize * 8 / static_cast<double> (cbr.GetBitRate ()));
-
-          // Update app attributes to the desired bit rate.
-          apps.Get (0)->SetAttribute (
-            "PktSize", PointerValue (
-              CreateObjectWithAttributes<ConstantRandomVariable> (
-                "Constant", DoubleValue (pktSize))));
-          apps.Get (1)->SetAttribute (
-            "PktSize", PointerValue (
-              CreateObjectWithAttributes<ConstantRandomVariable> (
-                "Constant", DoubleValue (pktSize))));
-          apps.Get (0)->SetAttribute (
-            "PktInterval", PointerValue (
-              CreateObjectWithAttributes<ConstantRandomVariable> (
-                "Constant", DoubleValue (pktInterval))));
-          apps.Get (1)->SetAttribute (
-            "PktInterval", PointerValue (
-              CreateObjectWithAttributes<ConstantRandomVariable> (
-                "Constant", DoubleValue (pktInterval))));
+          uint32_t pktSize = 1024;
+          Time pktInterval = Seconds (
+              pktSize * 8 / static_cast<double> (cbr.GetBitRate ()));
+
+          InstallApp (nodes1st.Get (i), nodes2nd.Get (i),
+                      addr1st.GetAddress (i), addr2nd.GetAddress (i),
+                      GetNextPortNo (nodes1st.Get (i), nodes2nd.Get (i)),
+                      m_DSCP, startCurrent, lengthTime, sliceId,
+                      pktSize, pktInterval);
 
           NS_LOG_INFO ("App " << j << " at host " << i <<
                       " will start at " << startCurrent.GetSeconds () <<
@@ -243,7 +320,9 @@ UdpPeerHelper::InstallApp (
   Ptr<Node> node1st, Ptr<Node> node2nd,
   Ipv4Address addr1st, Ipv4Address addr2nd,
   uint16_t portNo, Ipv4Header::DscpType dscp,
-  Time startTime, Time lengthTime, uint8_t sliceId)
+  Time startTime, Time lengthTime, uint8_t sliceId,
+  uint32_t pktSize, Time pktInterval,
+  uint32_t traceOffset, uint32_t traceStride)
 {
   // uint8_t ipTos = m_DSCP << 2;
   uint8_t ipTos = trafficTypeToDscpHeader(m_tQosType) << 2;
@@ -254,34 +333,92 @@ UdpPeerHelper::InstallApp (
   apps.Add (app1st);
   apps.Add (app2nd);
 
+  // Configure both apps directly, skipping attribute lookups.
+  UdpPeerApp::PeerConfig config;
+  config.localPort = portNo;
+  config.qosType = Dscp2QosType (m_DSCP);
+  config.tQosType = m_tQosType;
+  config.sliceId = sliceId;
+  config.elastic = m_elastic;
+  config.pktSize = pktSize;
+  config.pktInterval = pktInterval;
+  config.profile = m_profile;
+  config.traceFile = traceStride ? m_traceFile : std::string ();
+  config.traceOffset = traceOffset;
+  config.traceStride = traceStride;
+
   InetSocketAddress inetAddr2nd (addr2nd, portNo);
   inetAddr2nd.SetTos (ipTos);
-  app1st->SetAttribute ("LocalPort", UintegerValue (portNo));
-  app1st->SetAttribute ("PeerAddress", AddressValue (inetAddr2nd));
-  app1st->SetAttribute ("QosType", EnumValue (Dscp2QosType (m_DSCP)));
-  app1st->SetAttribute ("TQosType", EnumValue(m_tQosType));
-  app1st->SetAttribute ("SliceId", UintegerValue (sliceId));
-  node1st->AddApplication (app1st);
-
+  config.peerAddress = inetAddr2nd;
+  app1st->Configure (config);
+
+  // In distributed simulations, both apps are always created to keep the
+  // same random streams on all ranks, but only local apps are installed.
+  bool local1st = node1st->GetSystemId () == Simulator::GetSystemId ();
+  bool local2nd = node2nd->GetSystemId () == Simulator::GetSystemId ();
+  if (local1st)
+    {
+      node1st->AddApplication (app1st);
+      Simulator::Schedule (startTime, &UdpPeerApp::StartTraffic, app1st);
+      Simulator::Schedule (startTime + lengthTime, &UdpPeerApp::StopTraffic, app1st);
+    }
 
   InetSocketAddress inetAddr1st (addr1st, portNo);
   inetAddr1st.SetTos (ipTos);
-  app2nd->SetAttribute ("LocalPort", UintegerValue (portNo));
-  app2nd->SetAttribute ("PeerAddress", AddressValue (inetAddr1st));
-  app2nd->SetAttribute ("QosType", EnumValue (Dscp2QosType (m_DSCP)));
-  app2nd->SetAttribute ("TQosType", EnumValue(m_tQosType));
-  app2nd->SetAttribute ("SliceId", UintegerValue (sliceId));
-  node2nd->AddApplication (app2nd);
+  config.peerAddress = inetAddr1st;
+  config.traceFile = std::string ();
+  app2nd->Configure (config);
+  if (local2nd)
+    {
+      node2nd->AddApplication (app2nd);
+      if (m_fullDuplex && m_traceFile.empty ())
+        {
+          Simulator::Schedule (startTime, &UdpPeerApp::StartTraffic, app2nd);
+        }
+      Simulator::Schedule (startTime + lengthTime, &UdpPeerApp::StopTraffic, app2nd);
+    }
+
+  return apps;
+}
 
-  Simulator::Schedule (startTime, &UdpPeerApp::StartTraffic, app1st);
+ApplicationContainer
+UdpPeerHelper::InstallAggregateApp (
+  Ptr<Node> node1st, Ptr<Node> node2nd,
+  Ipv4Address addr1st, Ipv4Address addr2nd,
+  uint16_t portNo, uint8_t sliceId)
+{
+  uint8_t ipTos = trafficTypeToDscpHeader (m_tQosType) << 2;
 
-  if (m_fullDuplex)
+  ApplicationContainer apps;
+  Ptr<UdpAggregateApp> app1st = CreateObject<UdpAggregateApp> ();
+  Ptr<UdpAggregateApp> app2nd = CreateObject<UdpAggregateApp> ();
+  apps.Add (app1st);
+  apps.Add (app2nd);
+
+  // Configure both apps directly, skipping attribute lookups.
+  UdpAggregateApp::AggregateConfig config;
+  config.localPort = portNo;
+  config.expInterval = m_expInterval;
+  config.tQosType = m_tQosType;
+  config.sliceId = sliceId;
+
+  InetSocketAddress inetAddr2nd (addr2nd, portNo);
+  inetAddr2nd.SetTos (ipTos);
+  config.peerAddress = inetAddr2nd;
+  app1st->Configure (config);
+  if (node1st->GetSystemId () == Simulator::GetSystemId ())
     {
-      Simulator::Schedule (startTime, &UdpPeerApp::StartTraffic, app2nd);
+      node1st->AddApplication (app1st);
+    }
+
+  InetSocketAddress inetAddr1st (addr1st, portNo);
+  inetAddr1st.SetTos (ipTos);
+  config.peerAddress = inetAddr1st;
+  app2nd->Configure (config);
+  if (node2nd->GetSystemId () == Simulator::GetSystemId ())
+    {
+      node2nd->AddApplication (app2nd);
     }
-  
-  Simulator::Schedule (startTime + lengthTime, &UdpPeerApp::StopTraffic, app1st);
-  Simulator::Schedule (startTime + lengthTime, &UdpPeerApp::StopTraffic, app2nd);
 
   return apps;
 }
@@ -292,14 +429,27 @@ UdpPeerHelper::DoDispose ()
   m_startRng = 0;
   m_rateRng = 0;
   m_lengthRng = 0;
+  m_profile = 0;
   Object::DoDispose ();
 }
 
 uint16_t
-UdpPeerHelper::GetNextPortNo ()
+UdpPeerHelper::GetNextPortNo (Ptr<Node> node1st, Ptr<Node> node2nd)
 {
-  NS_ABORT_MSG_IF (m_port == 0xFFFF, "No more ports available for use.");
-  return m_port++;
+  // Ports only have to be unique on each node, so pick the first port that is
+  // still free on both nodes of this pair.
+  auto it1st = m_nodePorts.insert (
+      std::make_pair (node1st->GetId (), m_initPort)).first;
+  auto it2nd = m_nodePorts.insert (
+      std::make_pair (node2nd->GetId (), m_initPort)).first;
+  uint16_t port = std::max (it1st->second, it2nd->second);
+  NS_ABORT_MSG_IF (port == 0xFFFF, "No more ports available for use at "
+                   "nodes " << node1st->GetId () << " and " <<
+                   node2nd->GetId ());
+
+  it1st->second = port + 1;
+  it2nd->second = port + 1;
+  return port;
 }
 
 } // namespace ns3
@@ -21,10 +21,12 @@
 #ifndef UDP_PEER_HELPER_H
 #define UDP_PEER_HELPER_H
 
+#include <map>
 #include <ns3/core-module.h>
 #include <ns3/network-module.h>
 #include <ns3/internet-module.h>
 #include "udp-peer-app.h"
+#include "udp-aggregate-app.h"
 
 namespace ns3 {
 
@@ -97,13 +99,38 @@ public:
    * \param dscp The DSCP value used to set the socket Type of Service field.
    * \param startTime The time to start both applications.
    * \param lengthTime The length time for both applications.
+   * \param sliceId The slice ID.
+   * \param pktSize The fixed packet size (0 to use the app PktSize).
+   * \param pktInterval The fixed packet interval (0 to use the app
+   *        PktInterval).
+   * \param traceOffset The first trace record replayed by the first app.
+   * \param traceStride The trace record stride for the first app (0 for no
+   *        trace replay).
    * \return The container with the pair of applications created.
    */
   ApplicationContainer InstallApp (
     Ptr<Node> node1st, Ptr<Node> node2nd,
     Ipv4Address addr1st, Ipv4Address addr2nd,
     uint16_t portNo, Ipv4Header::DscpType dscp,
-    Time startTime, Time lengthTime, uint8_t sliceId);
+    Time startTime, Time lengthTime, uint8_t sliceId,
+    uint32_t pktSize = 0, Time pktInterval = Time (0),
+    uint32_t traceOffset = 0, uint32_t traceStride = 0);
+
+  /**
+   * Create a pair of aggregated applications on input nodes. Traffic flows
+   * are added to these applications by the Install method.
+   * \param node1st The node to install the first app.
+   * \param node2nd The node to install the second app.
+   * \param addr1st The IPv4 address of the first node.
+   * \param addr2nd The IPv4 address of the second mpde.
+   * \param portNo The port number for both nodes.
+   * \param sliceId The slice ID.
+   * \return The container with the pair of applications created.
+   */
+  ApplicationContainer InstallAggregateApp (
+    Ptr<Node> node1st, Ptr<Node> node2nd,
+    Ipv4Address addr1st, Ipv4Address addr2nd,
+    uint16_t portNo, uint8_t sliceId);
 
 protected:
   /** Destructor implementation. */
@@ -111,10 +138,12 @@ protected:
 
 private:
   /**
-   * Get the next port number available for use.
+   * Get the next port number available for use at both nodes.
+   * \param node1st The first node.
+   * \param node2nd The second node.
    * \return The port number to use.
    */
-  static uint16_t GetNextPortNo ();
+  static uint16_t GetNextPortNo (Ptr<Node> node1st, Ptr<Node> node2nd);
 
   ObjectFactory m_app1stFactory;   //!< Application factory.
   ObjectFactory m_app2ndFactory;   //!< Application factory.
@@ -127,10 +156,18 @@ private:
   Ptr<RandomVariableStream>   m_rateRng;      //!< The app traffic data rate.
   Ptr<RandomVariableStream>   m_lengthRng;    //!< The app traffic length.
   bool 			      m_split;
+  bool                        m_aggregate;    //!< Aggregated apps per host.
+  bool                        m_expInterval;  //!< Exponential intervals.
+  std::string                 m_traceFile;    //!< Trace file to replay.
+  std::string                 m_profileSpec;  //!< Demand profile string.
+  Ptr<DemandProfile>          m_profile;      //!< Parsed demand profile.
+  bool                        m_elastic;      //!< Elastic apps.
   Ipv4Header::DscpType m_DSCP; //!< DSCP type.
   TQosType m_tQosType; 
 
-  static uint16_t             m_port;         //!< Port numbers for apps.
+  static const uint16_t       m_initPort;     //!< Initial port number.
+  /** Map saving node ID / next port number available on this node. */
+  static std::map<uint32_t, uint16_t> m_nodePorts;
 };
 
 } // namespace ns3
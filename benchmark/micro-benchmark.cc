@@ -0,0 +1,563 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Thiago Guimarães <thiago.guimaraes@ice.ufjf.br>
+ *         Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <ns3/csma-module.h>
+#include "micro-benchmark.h"
+#include "../infrastructure/qos-queue.h"
+#include "../metadata/slice-tag.h"
+#include "../statistics/flow-stats-calculator.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MicroBenchmark");
+
+// Benchmark names and OpenFlow queue types for queue benchmarks.
+static const std::vector<std::pair<std::string, std::string> > g_queueTypes = {
+  {"queue-qos",       "ns3::QosQueue"},
+  {"queue-scenario1", "ns3::Scenario1queues"},
+  {"queue-scenario2", "ns3::Scenario2queues"},
+  {"queue-scenario3", "ns3::Scenario3queues"},
+  {"queue-scenario4", "ns3::Scenario4queues"}
+};
+
+// Other benchmark names.
+static const std::vector<std::string> g_otherBenchs = {
+  "slice-tag-serialize", "slice-tag-peek", "flow-stats-rx",
+  "link-tx", "link-ewma", "slicing-extra"
+};
+
+// Sink for benchmark results, so the compiler can't discard the work.
+static volatile uint64_t g_sink = 0;
+
+// Minimum number of operations in a timed block without batch setup.
+static const uint64_t g_minBlockOps = 1000;
+
+MicroBenchmark::MicroBenchmark (std::string filter, Time minTime,
+                                std::string filename)
+  : m_minTime (minTime),
+  m_filename (filename)
+{
+  NS_LOG_FUNCTION (this << filter << minTime << filename);
+
+  // Queue types hold at most four slices with three queues each.
+  bool all = (filter == "all");
+  for (auto const &queueType : g_queueTypes)
+    {
+      if (all || queueType.first.find (filter) != std::string::npos)
+        {
+          for (uint32_t slices : {1, 2, 4})
+            {
+              for (uint32_t depth : {1, 10, 100})
+                {
+                  m_cases.push_back ({queueType.first, slices, depth});
+                }
+            }
+        }
+    }
+  for (auto const &name : g_otherBenchs)
+    {
+      if (all || name.find (filter) != std::string::npos)
+        {
+          for (uint32_t slices : {1, 4, N_MAX_SLICES})
+            {
+              for (uint32_t depth : {1, 16, 256})
+                {
+                  m_cases.push_back ({name, slices, depth});
+                }
+            }
+        }
+    }
+  NS_ABORT_MSG_IF (m_cases.empty (), "No benchmark matching " << filter);
+}
+
+int
+MicroBenchmark::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  std::ofstream outFile;
+  if (!m_filename.empty ())
+    {
+      outFile.open (m_filename.c_str (), std::ofstream::out);
+      NS_ABORT_MSG_IF (!outFile.is_open (), "Can't open file " << m_filename);
+    }
+
+  int failed = 0;
+  for (auto const &bc : m_cases)
+    {
+      int fds [2];
+      NS_ABORT_MSG_IF (pipe (fds) < 0, "Can't create the result pipe.");
+      std::cout.flush ();
+      std::cerr.flush ();
+      pid_t pid = fork ();
+      NS_ABORT_MSG_IF (pid < 0, "Can't fork the benchmark process.");
+      if (pid == 0)
+        {
+          // The child process runs the case with a clean global state,
+          // discarding the output of the simulation components.
+          close (fds [0]);
+          NS_ABORT_MSG_IF (!std::freopen ("/dev/null", "w", stdout),
+                           "Can't redirect the benchmark output.");
+          std::string result = RunCase (bc) + "\n";
+          ssize_t written = write (fds [1], result.data (), result.size ());
+          close (fds [1]);
+          _exit (written == static_cast<ssize_t> (result.size ()) ? 0 : 1);
+        }
+
+      close (fds [1]);
+      std::string result;
+      char buffer [256];
+      ssize_t bytes;
+      while ((bytes = read (fds [0], buffer, sizeof (buffer))) > 0)
+        {
+          result.append (buffer, bytes);
+        }
+      close (fds [0]);
+
+      int status;
+      waitpid (pid, &status, 0);
+      if (!WIFEXITED (status) || WEXITSTATUS (status) != 0 || result.empty ())
+        {
+          failed++;
+          std::cout << "FAILED " << bc.name << " slices " << bc.slices
+                    << " depth " << bc.depth << std::endl;
+          continue;
+        }
+      std::cout << result << std::flush;
+      if (outFile.is_open ())
+        {
+          outFile << result << std::flush;
+        }
+    }
+  return failed;
+}
+
+std::string
+MicroBenchmark::RunCase (const Case &bc)
+{
+  NS_LOG_FUNCTION (this << bc.name << bc.slices << bc.depth);
+
+  for (auto const &queueType : g_queueTypes)
+    {
+      if (bc.name != queueType.first)
+        {
+          continue;
+        }
+
+      Config::SetDefault ("ns3::OFSwitch13Port::QueueFactory",
+                          StringValue (queueType.second));
+      Ptr<LinkInfo> link = CreateNetwork (bc.slices, CreateObject<Controller> ());
+      Ptr<OFSwitch13Queue> portQueue = link->GetPortQueue (0);
+      if (queueType.second == "ns3::QosQueue")
+        {
+          return BenchQueue<QosQueue> (bc, portQueue);
+        }
+      if (queueType.second == "ns3::Scenario1queues")
+        {
+          return BenchQueue<Scenario1queues> (bc, portQueue);
+        }
+      if (queueType.second == "ns3::Scenario2queues")
+        {
+          return BenchQueue<Scenario2queues> (bc, portQueue);
+        }
+      if (queueType.second == "ns3::Scenario3queues")
+        {
+          return BenchQueue<Scenario3queues> (bc, portQueue);
+        }
+      return BenchQueue<Scenario4queues> (bc, portQueue);
+    }
+
+  if (bc.name == "slice-tag-serialize")
+    {
+      return BenchSliceTagSerialize (bc);
+    }
+  if (bc.name == "slice-tag-peek")
+    {
+      return BenchSliceTagPeek (bc);
+    }
+  if (bc.name == "flow-stats-rx")
+    {
+      return BenchFlowStatsRx (bc);
+    }
+  if (bc.name == "link-tx")
+    {
+      return BenchLinkTx (bc);
+    }
+  if (bc.name == "link-ewma")
+    {
+      return BenchLinkEwma (bc);
+    }
+  if (bc.name == "slicing-extra")
+    {
+      return BenchSlicingExtra (bc);
+    }
+  NS_ABORT_MSG ("Unknown benchmark " << bc.name);
+}
+
+std::string
+MicroBenchmark::Measure (const Case &bc, SetupFn setup, BatchFn batch,
+                         uint64_t maxOps)
+{
+  NS_LOG_FUNCTION (this << bc.name);
+
+  // Warm up caches and lazily allocated structures.
+  if (setup)
+    {
+      setup ();
+    }
+  batch ();
+
+  std::vector<double> nsPerOp;
+  uint64_t totalOps = 0;
+  int64_t totalNs = 0;
+  int64_t minNs = m_minTime.GetNanoSeconds ();
+  while (nsPerOp.size () < 5 || (totalNs < minNs && totalOps < maxOps))
+    {
+      if (setup)
+        {
+          setup ();
+        }
+
+      // Without setup, repeat small batches to amortize the timer overhead.
+      uint64_t ops = 0;
+      auto start = std::chrono::steady_clock::now ();
+      do
+        {
+          ops += batch ();
+        }
+      while (!setup && ops < g_minBlockOps);
+      int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds> (
+          std::chrono::steady_clock::now () - start).count ();
+
+      NS_ABORT_MSG_IF (ops == 0, "Empty benchmark batch.");
+      totalOps += ops;
+      totalNs += ns;
+      nsPerOp.push_back (static_cast<double> (ns) / ops);
+    }
+  std::sort (nsPerOp.begin (), nsPerOp.end ());
+
+  std::ostringstream json;
+  json << std::fixed << std::setprecision (2)
+       << "{\"bench\":\"" << bc.name << "\""
+       << ",\"slices\":" << bc.slices
+       << ",\"depth\":" << bc.depth
+       << ",\"batches\":" << nsPerOp.size ()
+       << ",\"ops\":" << totalOps
+       << ",\"ns_per_op\":" << static_cast<double> (totalNs) / totalOps
+       << ",\"ns_per_op_median\":" << nsPerOp [nsPerOp.size () / 2]
+       << ",\"ns_per_op_min\":" << nsPerOp.front ()
+       << "}";
+  return json.str ();
+}
+
+Ptr<LinkInfo>
+MicroBenchmark::CreateNetwork (uint32_t slices, Ptr<Controller> controller)
+{
+  NS_LOG_FUNCTION (this << slices << controller);
+
+  Ptr<OFSwitch13InternalHelper> of13Helper = CreateObject<OFSwitch13InternalHelper> ();
+  of13Helper->SetDeviceAttribute ("PipelineTables", UintegerValue (OFS_TAB_TOTAL));
+  Ptr<Node> controllerNode = CreateObject<Node> ();
+  of13Helper->InstallController (controllerNode, controller);
+
+  NodeContainer switchNodes;
+  switchNodes.Create (2);
+  OFSwitch13DeviceContainer switchDevices;
+  switchDevices = of13Helper->InstallSwitch (switchNodes);
+
+  CsmaHelper csmaHelper;
+  csmaHelper.SetChannelAttribute ("DataRate", DataRateValue (DataRate ("160Mbps")));
+  csmaHelper.SetChannelAttribute ("Delay", TimeValue (MilliSeconds (0)));
+  NetDeviceContainer pairDevs;
+  pairDevs = csmaHelper.Install (switchNodes.Get (0), switchNodes.Get (1));
+
+  PortsList_t switchPorts;
+  switchPorts.push_back (switchDevices.Get (0)->AddSwitchPort (pairDevs.Get (0)));
+  switchPorts.push_back (switchDevices.Get (1)->AddSwitchPort (pairDevs.Get (1)));
+  Ptr<LinkInfo> link = CreateObject<LinkInfo> (
+      switchPorts.at (0), switchPorts.at (1), pairDevs.Get (0)->GetChannel ());
+
+  of13Helper->CreateOpenFlowChannels ();
+  controller->NotifySwitches (switchDevices, switchPorts);
+
+  // Slices with bandwidth sharing, split in three priority levels.
+  SliceInfoList_t sliceList;
+  for (uint32_t s = 1; s <= slices; s++)
+    {
+      sliceList.push_back (CreateObjectWithAttributes<SliceInfo> (
+                             "SliceId", UintegerValue (s),
+                             "Priority", UintegerValue (s % 3),
+                             "Quota", UintegerValue (100 / slices)));
+    }
+  controller->NotifySlices (sliceList);
+
+  // Complete the OpenFlow handshake and the initial rule installation.
+  Simulator::Stop (Seconds (1));
+  Simulator::Run ();
+  return link;
+}
+
+template <class T>
+std::string
+MicroBenchmark::BenchQueue (const Case &bc, Ptr<OFSwitch13Queue> portQueue)
+{
+  NS_LOG_FUNCTION (this << bc.name);
+
+  Ptr<T> queue = DynamicCast<T> (portQueue);
+  NS_ABORT_MSG_IF (!queue, "Invalid port queue type for " << bc.name);
+  NS_ABORT_MSG_IF (bc.depth > 100, "Queue depth over internal queue size.");
+
+  // Backlog the three queues of each slice (or all queues, when fewer).
+  int nQueues = std::min<int> (queue->GetNQueues (), 3 * bc.slices);
+  Ptr<Packet> packet = Create<Packet> (1000);
+  SetupFn fill = [&] ()
+    {
+      for (int q = 0; q < nQueues; q++)
+        {
+          for (uint32_t d = 0; d < bc.depth; d++)
+            {
+              queue->GetQueue (q)->Enqueue (packet);
+            }
+        }
+    };
+
+  // Drain all queues in the scheduler output order.
+  BatchFn drain = [&] ()
+    {
+      uint64_t ops = 0;
+      int queueId;
+      while ((queueId = queue->GetNextQueueToServe ()) >= 0)
+        {
+          queue->GetQueue (queueId)->Dequeue ();
+          ops++;
+        }
+      return ops;
+    };
+
+  return Measure (bc, fill, drain);
+}
+
+std::string
+MicroBenchmark::BenchSliceTagSerialize (const Case &bc)
+{
+  NS_LOG_FUNCTION (this << bc.name);
+
+  std::vector<SliceTag> tags;
+  for (uint32_t i = 0; i < bc.depth; i++)
+    {
+      tags.push_back (SliceTag (1 + i % bc.slices,
+                                static_cast<TQosType> (i % N_TRAFFIC_TYPES),
+                                NanoSeconds (i)));
+    }
+  std::vector<uint8_t> buffer (tags.front ().GetSerializedSize ());
+  uint8_t *start = buffer.data ();
+  uint8_t *end = start + buffer.size ();
+
+  BatchFn batch = [&] ()
+    {
+      SliceTag decoded;
+      for (auto const &tag : tags)
+        {
+          tag.Serialize (TagBuffer (start, end));
+          decoded.Deserialize (TagBuffer (start, end));
+          g_sink += decoded.GetSliceId ();
+        }
+      return static_cast<uint64_t> (tags.size ());
+    };
+
+  return Measure (bc, SetupFn (), batch);
+}
+
+std::string
+MicroBenchmark::BenchSliceTagPeek (const Case &bc)
+{
+  NS_LOG_FUNCTION (this << bc.name);
+
+  std::vector<Ptr<Packet> > packets;
+  for (uint32_t i = 0; i < bc.depth; i++)
+    {
+      Ptr<Packet> packet = Create<Packet> (1000);
+      packet->AddPacketTag (SliceTag (1 + i % bc.slices,
+                                      static_cast<TQosType> (i % N_TRAFFIC_TYPES),
+                                      NanoSeconds (i)));
+      packets.push_back (packet);
+    }
+
+  BatchFn batch = [&] ()
+    {
+      SliceTag tag;
+      for (auto const &packet : packets)
+        {
+          packet->PeekPacketTag (tag);
+          g_sink += tag.GetSliceId ();
+        }
+      return static_cast<uint64_t> (packets.size ());
+    };
+
+  return Measure (bc, SetupFn (), batch);
+}
+
+std::string
+MicroBenchmark::BenchFlowStatsRx (const Case &bc)
+{
+  NS_LOG_FUNCTION (this << bc.name);
+
+  std::vector<Ptr<FlowStatsCalculator> > calculators;
+  for (uint32_t s = 0; s < bc.slices; s++)
+    {
+      calculators.push_back (CreateObject<FlowStatsCalculator> ());
+    }
+
+  // Packet timestamps in the past, spreading delays up to 1ms.
+  std::vector<Time> timestamps;
+  for (uint32_t i = 0; i < bc.depth; i++)
+    {
+      timestamps.push_back (NanoSeconds (-static_cast<int64_t> ((i * 7919) % 1000000)));
+    }
+
+  BatchFn batch = [&] ()
+    {
+      for (uint32_t i = 0; i < bc.depth; i++)
+        {
+          calculators [i % bc.slices]->NotifyRx (1000 + i % 500, timestamps [i]);
+        }
+      return static_cast<uint64_t> (bc.depth);
+    };
+
+  return Measure (bc, SetupFn (), batch);
+}
+
+std::string
+MicroBenchmark::BenchLinkTx (const Case &bc)
+{
+  NS_LOG_FUNCTION (this << bc.name);
+
+  Ptr<LinkInfo> link = CreateNetwork (bc.slices, CreateObject<Controller> ());
+
+  std::vector<Ptr<Packet> > packets;
+  for (uint32_t i = 0; i < bc.depth; i++)
+    {
+      Ptr<Packet> packet = Create<Packet> (1000);
+      packet->AddPacketTag (SliceTag (1 + i % bc.slices,
+                                      static_cast<TQosType> (i % N_TRAFFIC_TYPES),
+                                      NanoSeconds (i)));
+      packets.push_back (packet);
+    }
+  const std::string contexts [2] = {"Forward", "Backward"};
+
+  BatchFn batch = [&] ()
+    {
+      for (uint32_t i = 0; i < bc.depth; i++)
+        {
+          link->NotifyTxPacket (contexts [i % 2], packets [i]);
+        }
+      return static_cast<uint64_t> (bc.depth);
+    };
+
+  return Measure (bc, SetupFn (), batch);
+}
+
+std::string
+MicroBenchmark::BenchLinkEwma (const Case &bc)
+{
+  NS_LOG_FUNCTION (this << bc.name);
+
+  Ptr<LinkInfo> link = CreateNetwork (bc.slices, CreateObject<Controller> ());
+
+  // The simulation time doesn't advance, so the last update time is moved
+  // back by one interval before each update, after refilling TX counters.
+  Time lastTime = Simulator::Now () - link->m_ewmaTimeout;
+  BatchFn batch = [&] ()
+    {
+      for (uint32_t i = 0; i < bc.depth; i++)
+        {
+          for (uint32_t s = 1; s <= bc.slices; s++)
+            {
+              for (int d = 0; d < N_LINK_DIRS; d++)
+                {
+                  link->m_slices [d][s].txBytes [TQosType::BE] = 125000;
+                  link->m_slices [d][s].txBytes [TQosType::ALL] = 125000;
+                }
+            }
+          link->m_ewmaLastTime = lastTime;
+          link->EwmaUpdate ();
+        }
+      return static_cast<uint64_t> (bc.depth);
+    };
+
+  // Each update schedules the next one, so limit the number of pending events.
+  return Measure (bc, SetupFn (), batch, 200000);
+}
+
+std::string
+MicroBenchmark::BenchSlicingExtra (const Case &bc)
+{
+  NS_LOG_FUNCTION (this << bc.name);
+
+  Ptr<Controller> controller = CreateObjectWithAttributes<Controller> (
+      "SliceMode", EnumValue (SliceMode::DYNA));
+  Ptr<LinkInfo> link = CreateNetwork (bc.slices, controller);
+
+  // Before each batch, deliver the meter updates from the previous one and
+  // set the link usage, alternating underloaded and overloaded slices.
+  bool swap = false;
+  SetupFn setup = [&] ()
+    {
+      Simulator::Stop (MilliSeconds (10));
+      Simulator::Run ();
+      swap = !swap;
+      for (uint32_t s = 1; s <= bc.slices; s++)
+        {
+          for (int d = 0; d < N_LINK_DIRS; d++)
+            {
+              LinkInfo::LinkDir dir = static_cast<LinkInfo::LinkDir> (d);
+              int64_t quota = link->GetQuoBitRate (dir, s);
+              bool overloaded = ((s % 2) == 0) == swap;
+              link->m_slices [d][s].ewmaThp [TQosType::ALL] =
+                overloaded ? quota * 3 / 2 : quota / 4;
+            }
+        }
+    };
+
+  BatchFn batch = [&] ()
+    {
+      for (uint32_t i = 0; i < bc.depth; i++)
+        {
+          for (int d = 0; d < N_LINK_DIRS; d++)
+            {
+              controller->SlicingExtraAdjust (
+                link, static_cast<LinkInfo::LinkDir> (d));
+            }
+        }
+      return static_cast<uint64_t> (bc.depth * N_LINK_DIRS);
+    };
+
+  return Measure (bc, setup, batch);
+}
+
+} // namespace ns3
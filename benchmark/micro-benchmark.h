@@ -0,0 +1,144 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Thiago Guimarães <thiago.guimaraes@ice.ufjf.br>
+ *         Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+#ifndef MICRO_BENCHMARK_H
+#define MICRO_BENCHMARK_H
+
+#include <functional>
+#include <ns3/core-module.h>
+#include <ns3/network-module.h>
+#include <ns3/ofswitch13-module.h>
+#include "../infrastructure/controller.h"
+
+namespace ns3 {
+
+/**
+ * Micro-benchmark suite for the simulation hot paths. Each benchmark case is
+ * a benchmark name with a slice count and a depth, executed in its own forked
+ * process so global state (simulator, slice and link lists) never leaks
+ * between cases. A case runs timed batches until the minimum measuring time
+ * elapses, and its result is written as one JSON object per line.
+ *
+ * The depth is the number of packets in each backlogged internal queue for
+ * the queue benchmarks, and the number of operations per timed batch for the
+ * others. Available benchmarks:
+ * - queue-<type>: GetNextQueueToServe and internal dequeue, draining the
+ *   queues of the given number of slices for each OpenFlow queue type;
+ * - slice-tag-serialize: SliceTag serialization to and from a tag buffer;
+ * - slice-tag-peek: SliceTag lookup on tagged packets;
+ * - flow-stats-rx: FlowStatsCalculator::NotifyRx over per-slice calculators;
+ * - link-tx: LinkInfo::NotifyTxPacket on tagged packets;
+ * - link-ewma: LinkInfo::EwmaUpdate with the given number of loaded slices;
+ * - slicing-extra: Controller::SlicingExtraAdjust in both link directions,
+ *   with synthetic link usage alternating between underloaded and
+ *   overloaded slices.
+ */
+class MicroBenchmark
+{
+public:
+  /**
+   * Complete constructor.
+   * \param filter Run only benchmarks whose name contains this string, or all
+   *        of them for the "all" string.
+   * \param minTime The minimum measuring time for each case.
+   * \param filename The output filename (empty for stdout only).
+   */
+  MicroBenchmark (std::string filter, Time minTime, std::string filename);
+
+  /**
+   * Run all selected benchmark cases.
+   * \return The number of failed cases.
+   */
+  int Run (void);
+
+private:
+  /** A benchmark case. */
+  struct Case
+  {
+    std::string name;     //!< Benchmark name.
+    uint32_t    slices;   //!< Number of slices.
+    uint32_t    depth;    //!< Queue depth or batch size.
+  };
+
+  /** Untimed preparation for the next batch. */
+  typedef std::function<void (void)> SetupFn;
+
+  /** Timed batch, returning the number of operations executed. */
+  typedef std::function<uint64_t (void)> BatchFn;
+
+  /**
+   * Run a single benchmark case. This is only called at the child process.
+   * \param bc The benchmark case.
+   * \return The JSON result line.
+   */
+  std::string RunCase (const Case &bc);
+
+  /**
+   * Measure batches until the minimum measuring time or the maximum number
+   * of operations is reached.
+   * \param bc The benchmark case.
+   * \param setup The untimed batch preparation.
+   * \param batch The timed batch.
+   * \param maxOps The maximum number of operations.
+   * \return The JSON result line.
+   */
+  std::string Measure (const Case &bc, SetupFn setup, BatchFn batch,
+                       uint64_t maxOps = UINT64_MAX);
+
+  /**
+   * Create the controller, two switches connected by a link, and the network
+   * slices, as in the simulation scenario.
+   * \param slices The number of slices.
+   * \param controller The controller application.
+   * \return The link between the switches.
+   */
+  Ptr<LinkInfo> CreateNetwork (uint32_t slices, Ptr<Controller> controller);
+
+  /**
+   * Benchmark the output scheduling of an OpenFlow queue type.
+   * \param bc The benchmark case.
+   * \param portQueue The switch port queue.
+   * \return The JSON result line.
+   */
+  template <class T>
+  std::string BenchQueue (const Case &bc, Ptr<OFSwitch13Queue> portQueue);
+
+  /**
+   * \name Other benchmarks.
+   * \param bc The benchmark case.
+   * \return The JSON result line.
+   */
+  //\{
+  std::string BenchSliceTagSerialize  (const Case &bc);
+  std::string BenchSliceTagPeek       (const Case &bc);
+  std::string BenchFlowStatsRx        (const Case &bc);
+  std::string BenchLinkTx             (const Case &bc);
+  std::string BenchLinkEwma           (const Case &bc);
+  std::string BenchSlicingExtra       (const Case &bc);
+  //\}
+
+  std::vector<Case>     m_cases;      //!< Selected benchmark cases.
+  Time                  m_minTime;    //!< Minimum measuring time per case.
+  std::string           m_filename;   //!< Output filename.
+};
+
+} // namespace ns3
+#endif /* MICRO_BENCHMARK_H */
@@ -22,6 +22,7 @@
 #ifdef NS3_OFSWITCH13
 
 #include "controller.h"
+#include "../statistics/runtime-profiler.h"
 
 namespace ns3 {
 
@@ -77,11 +78,18 @@ Controller::GetTypeId (void)
                    MakeTimeAccessor (&Controller::m_sliceTimeout),
                    MakeTimeChecker ())
     .AddAttribute ("SpareUse", "Use spare link bit rate for sharing purposes.",
-                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
                    EnumValue (OpMode::ON),
                    MakeEnumAccessor (&Controller::m_spareUse),
                    MakeEnumChecker (OpMode::OFF, OpModeStr (OpMode::OFF),
                                     OpMode::ON,  OpModeStr (OpMode::ON)))
+    .AddAttribute ("StaticArp",
+                   "Hosts have static ARP entries for their peers, so "
+                   "switches drop ARP packets instead of flooding them.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   EnumValue (OpMode::OFF),
+                   MakeEnumAccessor (&Controller::m_staticArp),
+                   MakeEnumChecker (OpMode::OFF, OpModeStr (OpMode::OFF),
+                                    OpMode::ON,  OpModeStr (OpMode::ON)))
   ;
   return tid;
 }
@@ -247,6 +255,73 @@ Controller::GetSliceList (bool sharing) const
   return (sharing ? m_slicesSha : m_slicesAll);
 }
 
+void
+Controller::ChangeSliceMode (SliceMode mode)
+{
+  NS_LOG_FUNCTION (this << mode);
+
+  if (mode == m_sliceMode)
+    {
+      return;
+    }
+  NS_ABORT_MSG_IF ((mode != SliceMode::STAT && mode != SliceMode::DYNA)
+                   || (m_sliceMode != SliceMode::STAT
+                       && m_sliceMode != SliceMode::DYNA),
+                   "Can't change inter-slicing mode from " <<
+                   SliceModeStr (m_sliceMode) << " to " <<
+                   SliceModeStr (mode) << " at runtime.");
+
+  m_sliceMode = mode;
+  if (mode == SliceMode::DYNA)
+    {
+      m_sliceEvent = Simulator::Schedule (
+          m_sliceTimeout, &Controller::SlicingDynamicTimeout, this);
+      return;
+    }
+
+  // Back to static mode: remove the extra bit rate from all slices.
+  m_sliceEvent.Cancel ();
+  for (auto const &link : LinkInfo::GetList ())
+    {
+      for (auto const &slice : GetSliceList (true))
+        {
+          for (int d = 0; d < N_LINK_DIRS; d++)
+            {
+              LinkInfo::LinkDir dir = static_cast<LinkInfo::LinkDir> (d);
+              int64_t sliceExt = link->GetExtBitRate (dir, slice->GetSliceId ());
+              if (sliceExt)
+                {
+                  bool success = link->UpdateExtBitRate (
+                      dir, slice->GetSliceId (), -sliceExt);
+                  NS_ASSERT_MSG (success, "Error when updating extra bit rate.");
+                }
+            }
+          SlicingMeterAdjust (link, slice->GetSliceId ());
+        }
+    }
+}
+
+void
+Controller::ReapplySlicing (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  for (auto const &link : LinkInfo::GetList ())
+    {
+      for (auto const &slice : GetSliceList (true))
+        {
+          SlicingMeterAdjust (link, slice->GetSliceId ());
+        }
+    }
+
+  if (m_sliceMode == SliceMode::DYNA)
+    {
+      m_sliceEvent.Cancel ();
+      m_sliceEvent = Simulator::Schedule (
+          m_sliceTimeout, &Controller::SlicingDynamicTimeout, this);
+    }
+}
+
 void
 Controller::DoDispose ()
 {
@@ -266,7 +341,8 @@ Controller::NotifyConstructionCompleted (void)
   // dynamic inter-slicing operation mode.
   if (m_sliceMode == SliceMode::DYNA)
     {
-      Simulator::Schedule (m_sliceTimeout, &Controller::SlicingDynamicTimeout, this);
+      m_sliceEvent = Simulator::Schedule (
+          m_sliceTimeout, &Controller::SlicingDynamicTimeout, this);
     }
 
   OFSwitch13Controller::NotifyConstructionCompleted ();
@@ -359,8 +435,17 @@ Controller::HandshakeSuccessful (Ptr<const RemoteSwitch> swtch)
   DpctlExecute (swDpId, "flow-mod cmd=add,table=1,prio=0 goto:2");
   DpctlExecute (swDpId, "flow-mod cmd=add,table=2,prio=0 ");
 
-  // Flood all ARP packets
-  DpctlExecute (swDpId, "flow-mod cmd=add,table=0,prio=10 eth_type=0x0806 apply:output=flood");
+  if (m_staticArp == OpMode::ON)
+    {
+      // Drop all ARP packets, as hosts never need to resolve addresses. This
+      // entry also keeps them away from the table-miss entry.
+      DpctlExecute (swDpId, "flow-mod cmd=add,table=0,prio=10 eth_type=0x0806");
+    }
+  else
+    {
+      // Flood all ARP packets
+      DpctlExecute (swDpId, "flow-mod cmd=add,table=0,prio=10 eth_type=0x0806 apply:output=flood");
+    }
 
   // Install rules for QoS output queues.
   // for (auto const &it : Dscp2QueueMap ())
@@ -578,6 +663,8 @@ Controller::SlicingDynamicTimeout (void)
 {
   NS_LOG_FUNCTION (this);
 
+  RuntimeProfiler::Scope profScope (RuntimeProfiler::CTRL_SLICING);
+
   // Adjust the extra bit rates in both directions for each backhaul link.
   for (auto &link : LinkInfo::GetList ())
     {
@@ -588,7 +675,8 @@ Controller::SlicingDynamicTimeout (void)
     }
 
   // Schedule the next slicing extra timeout operation.
-  Simulator::Schedule (m_sliceTimeout, &Controller::SlicingDynamicTimeout, this);
+  m_sliceEvent = Simulator::Schedule (
+      m_sliceTimeout, &Controller::SlicingDynamicTimeout, this);
 }
 
 void
@@ -45,6 +45,8 @@ typedef std::vector<Ptr<OFSwitch13Port> > PortsList_t;
  */
 class Controller : public OFSwitch13Controller
 {
+  friend class MicroBenchmark;
+
 public:
   Controller ();          //!< Default constructor
   virtual ~Controller (); //!< Dummy destructor.
@@ -87,6 +89,23 @@ public:
    */
   const SliceInfoList_t& GetSliceList (bool sharing = false) const;
 
+  /**
+   * Change the inter-slicing operation mode while the simulation is running.
+   * Only the static and dynamic modes can be switched, as both use the same
+   * individual meter entries. Leaving the dynamic mode removes any extra bit
+   * rate assigned to slices.
+   * \param mode The new inter-slicing operation mode.
+   */
+  void ChangeSliceMode (SliceMode mode);
+
+  /**
+   * Reapply the inter-slicing configuration after changing attributes while
+   * the simulation is running. This adjusts the slicing meters over all links
+   * right away, so a new SpareUse value also applies in the shared mode, and
+   * restarts the dynamic slice timeout with the current SliceTimeout value.
+   */
+  void ReapplySlicing (void);
+
 protected:
   /** Destructor implementation */
   virtual void DoDispose ();
@@ -147,7 +166,9 @@ private:
   DataRate              m_meterStep;      //!< Meter adjustment step.
   SliceMode             m_sliceMode;      //!< Inter-slicing operation mode.
   Time                  m_sliceTimeout;   //!< Dynamic slice timeout interval.
+  EventId               m_sliceEvent;     //!< Dynamic slice timeout event.
   OpMode                m_spareUse;       //!< Spare bit rate sharing mode.
+  OpMode                m_staticArp;      //!< Static ARP mode.
   SliceInfoList_t       m_slicesAll;      //!< All slices.
   SliceInfoList_t       m_slicesSha;      //!< Slices sharing bandwidth
   uint8_t m_scenarioConfig;
@@ -0,0 +1,117 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Thiago Guimarães <thiago.guimaraes@ice.ufjf.br>
+ *         Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+#include <ns3/arp-cache.h>
+#include <ns3/ipv4-interface.h>
+#include "light-stack-helper.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LightStackHelper");
+
+LightStackHelper::LightStackHelper ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LightStackHelper::~LightStackHelper ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+LightStackHelper::Install (NodeContainer nodes) const
+{
+  NS_LOG_FUNCTION (this);
+
+  for (NodeContainer::Iterator it = nodes.Begin (); it != nodes.End (); ++it)
+    {
+      Ptr<Node> node = *it;
+      NS_ASSERT_MSG (!node->GetObject<Ipv4> (),
+                     "IPv4 stack already installed into this node.");
+
+      // Same aggregation order used by the InternetStackHelper.
+      CreateAndAggregate (node, "ns3::ArpL3Protocol");
+      CreateAndAggregate (node, "ns3::Ipv4L3Protocol");
+      CreateAndAggregate (node, "ns3::Icmpv4L4Protocol");
+      Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+      ipv4->SetRoutingProtocol (m_routingHelper.Create (node));
+      CreateAndAggregate (node, "ns3::TrafficControlLayer");
+      CreateAndAggregate (node, "ns3::UdpL4Protocol");
+    }
+}
+
+Ipv4InterfaceContainer
+LightStackHelper::Assign (const NetDeviceContainer &devices,
+                          Ipv4AddressHelper &addrHelper, Ipv4Mask mask) const
+{
+  NS_LOG_FUNCTION (this);
+
+  Ipv4InterfaceContainer ifaces;
+  for (uint32_t i = 0; i < devices.GetN (); i++)
+    {
+      Ptr<NetDevice> device = devices.Get (i);
+      Ptr<Ipv4> ipv4 = device->GetNode ()->GetObject<Ipv4> ();
+      NS_ASSERT_MSG (ipv4, "Lightweight stack not installed into this node.");
+
+      // No queue disc here, so packets go straight into the device queue.
+      int32_t ifIndex = ipv4->GetInterfaceForDevice (device);
+      if (ifIndex == -1)
+        {
+          ifIndex = ipv4->AddInterface (device);
+        }
+      ipv4->AddAddress (ifIndex, Ipv4InterfaceAddress (
+                          addrHelper.NewAddress (), mask));
+      ipv4->SetMetric (ifIndex, 1);
+      ipv4->SetUp (ifIndex);
+      ifaces.Add (ipv4, ifIndex);
+    }
+  return ifaces;
+}
+
+void
+LightStackHelper::AddNeighbor (std::pair<Ptr<Ipv4>, uint32_t> iface,
+                               Ipv4Address address, Address mac)
+{
+  NS_LOG_FUNCTION (iface.second << address << mac);
+
+  Ptr<Ipv4L3Protocol> ipv4 = iface.first->GetObject<Ipv4L3Protocol> ();
+  Ptr<ArpCache> cache = ipv4->GetInterface (iface.second)->GetArpCache ();
+  NS_ASSERT_MSG (cache, "No ARP cache for this interface.");
+
+  ArpCache::Entry *entry = cache->Lookup (address);
+  if (!entry)
+    {
+      entry = cache->Add (address);
+    }
+  entry->SetMacAddress (mac);
+  entry->MarkPermanent ();
+}
+
+void
+LightStackHelper::CreateAndAggregate (Ptr<Node> node, std::string typeId)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (typeId);
+  node->AggregateObject (factory.Create<Object> ());
+}
+
+} // namespace ns3
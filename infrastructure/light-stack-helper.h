@@ -0,0 +1,84 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Thiago Guimarães <thiago.guimaraes@ice.ufjf.br>
+ *         Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+#ifndef LIGHT_STACK_HELPER_H
+#define LIGHT_STACK_HELPER_H
+
+#include <ns3/core-module.h>
+#include <ns3/network-module.h>
+#include <ns3/internet-module.h>
+
+namespace ns3 {
+
+/**
+ * This helper installs a lightweight IPv4 stack into slice hosts, as an
+ * alternative to the InternetStackHelper. Hosts only run UDP applications on
+ * a single subnet, so the stack has only ARP, IPv4, ICMPv4, UDP and static
+ * routing, without the IPv6 and TCP protocols, the global routing, and the
+ * packet socket factory. Addresses are assigned without installing the
+ * default queue disc.
+ */
+class LightStackHelper
+{
+public:
+  LightStackHelper ();          //!< Default constructor.
+  virtual ~LightStackHelper (); //!< Dummy destructor.
+
+  /**
+   * Install the lightweight stack into each node.
+   * \param nodes The host nodes.
+   */
+  void Install (NodeContainer nodes) const;
+
+  /**
+   * Assign IPv4 addresses to the devices, bringing their interfaces up.
+   * \param devices The host devices, one per node.
+   * \param addrHelper The helper with the base address for the next address.
+   * \param mask The network mask.
+   * \return The interface container for the assigned addresses.
+   */
+  Ipv4InterfaceContainer Assign (const NetDeviceContainer &devices,
+                                 Ipv4AddressHelper &addrHelper,
+                                 Ipv4Mask mask) const;
+
+  /**
+   * Add a permanent ARP entry into the cache of a host interface. This works
+   * for any IPv4 stack, including the one from the InternetStackHelper.
+   * \param iface The host interface (IPv4 and interface index).
+   * \param address The neighbor IPv4 address.
+   * \param mac The neighbor MAC address.
+   */
+  static void AddNeighbor (std::pair<Ptr<Ipv4>, uint32_t> iface,
+                           Ipv4Address address, Address mac);
+
+private:
+  /**
+   * Create an object from the given type and aggregate it to the node.
+   * \param node The node.
+   * \param typeId The object type name.
+   */
+  static void CreateAndAggregate (Ptr<Node> node, std::string typeId);
+
+  Ipv4StaticRoutingHelper   m_routingHelper;  //!< Static routing helper.
+};
+
+} // namespace ns3
+#endif /* LIGHT_STACK_HELPER_H */
@@ -19,6 +19,7 @@
  */
 
 #include "qos-queue.h"
+#include "../statistics/runtime-profiler.h"
 
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT \
@@ -56,6 +57,8 @@ QosQueue::Dequeue (void)
 {
   NS_LOG_FUNCTION (this);
 
+  RuntimeProfiler::Scope profScope (RuntimeProfiler::QUEUE_DEQUEUE);
+
   int queueId = GetNextQueueToServe ();
   if (queueId >= 0)
     {
@@ -19,6 +19,7 @@
  */
 
 #include "scenario3.h"
+#include "../statistics/runtime-profiler.h"
 
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT \
@@ -57,6 +58,8 @@ Scenario3queues::Dequeue (void)
   
   NS_LOG_FUNCTION (this);
 
+  RuntimeProfiler::Scope profScope (RuntimeProfiler::QUEUE_DEQUEUE);
+
   int queueId = GetNextQueueToServe ();
   if (queueId >= 0)
     {
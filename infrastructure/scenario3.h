@@ -35,6 +35,8 @@ namespace ns3 {
  */
 class Scenario3queues : public OFSwitch13Queue
 {
+  friend class MicroBenchmark;
+
 public:
   /**
    * Register this type.
@@ -24,18 +24,27 @@
 #include <ns3/core-module.h>
 #include <ns3/network-module.h>
 #include <ns3/csma-module.h>
+#include <ns3/point-to-point-module.h>
 #include <ns3/internet-module.h>
 #include <ns3/ofswitch13-module.h>
 #include <ns3/applications-module.h>
 #include <ns3/mobility-module.h>
 #include <ns3/internet-apps-module.h>
 #include <ns3/flow-monitor-helper.h>
+#ifdef NS3_MPI
+#include <ns3/mpi-interface.h>
+#endif
+#include <sys/wait.h>
+#include <unistd.h>
 
 
 #include "infrastructure/controller.h"
+#include "infrastructure/light-stack-helper.h"
 #include "application/udp-peer-helper.h"
+#include "benchmark/micro-benchmark.h"
 #include "metadata/slice-info.h"
 #include "statistics/network-statistics.h"
+#include "statistics/runtime-profiler.h"
 
 #include "infrastructure/scenario1.h"
 #include "infrastructure/scenario2.h"
@@ -78,6 +87,8 @@ void ForceDefaults      (void);
 void EnableProgress     (int);
 void EnableVerbose      (bool);
 void EnableOfsLogs      (bool);
+int  ForkChildren       (uint32_t, uint32_t, uint32_t&);
+void ApplyVariant       (Ptr<Controller>, std::string);
 
 static std::string scenarioQueues;
 
@@ -88,8 +99,18 @@ main (int argc, char *argv[])
   bool        ofsLog    = false;
   bool        verbose   = false;
   bool        trace     = false;
+  bool        profile   = false;
   int         progress  = 1;
+  uint32_t    replicas  = 1;
+  uint32_t    maxParallel = 0;
+  Time        warmUp    = Seconds (0);
+  std::string variants  = std::string ();
   std::string prefix    = std::string ();
+  bool        distributed = false;
+  Time        linkDelay   = MilliSeconds (1);
+  std::string bench       = std::string ();
+  Time        benchTime   = MilliSeconds (200);
+  std::string benchOutput = std::string ("micro-benchmarks.jsonl");
 
   // Configure command line parameters
   CommandLine cmd;
@@ -98,11 +119,39 @@ main (int argc, char *argv[])
   cmd.AddValue ("Verbose",  "Enable verbose output.", verbose);
   cmd.AddValue ("OfsLog",   "Enable ofsoftswitch13 logs.", ofsLog);
   cmd.AddValue ("Trace",    "Enable pcap traces", trace);
+  cmd.AddValue ("Profile",  "Enable the wall-clock runtime profiler.", profile);
+  cmd.AddValue ("Replications", "Number of replications with consecutive "
+                "RngRun values, sharing the network setup.", replicas);
+  cmd.AddValue ("MaxParallel", "Maximum number of replications or variants "
+                "running at the same time (0 for the number of CPUs).",
+                maxParallel);
+  cmd.AddValue ("WarmUp", "Warm-up time before forking what-if variants.",
+                warmUp);
+  cmd.AddValue ("Variants", "What-if controller variants, separated by ';', "
+                "each as Attribute=value[,Attribute=value].", variants);
+  cmd.AddValue ("Distributed", "Split the network between two MPI ranks.",
+                distributed);
+  cmd.AddValue ("LinkDelay", "Delay of links crossing MPI ranks.", linkDelay);
+  cmd.AddValue ("Bench", "Run the micro-benchmarks with this name (or all) "
+                "instead of a simulation.", bench);
+  cmd.AddValue ("BenchTime", "Minimum measuring time for each benchmark case.",
+                benchTime);
+  cmd.AddValue ("BenchOutput", "Output file for benchmark results, "
+                "one JSON object per line.", benchOutput);
   cmd.Parse (argc, argv);
 
+  // The benchmark mode doesn't use input files or the simulation scenario.
+  if (!bench.empty ())
+    {
+      ForceDefaults ();
+      MicroBenchmark benchmark (bench, benchTime, benchOutput);
+      return benchmark.Run () ? 1 : 0;
+    }
+
   // Update input and output prefixes from command line prefix parameter.
   // This way, all files from this simulation will have the same prefix.
   NS_ASSERT_MSG (!prefix.empty (), "Unknown prefix.");
+  NS_ASSERT_MSG (replicas > 0, "Invalid number of replications.");
   std::ostringstream inputPrefix, outputPrefix;
   inputPrefix << prefix;
   char lastChar = *prefix.rbegin ();
@@ -139,6 +188,34 @@ main (int argc, char *argv[])
   cmd.Parse (argc, argv);
   ForceDefaults ();
 
+  // In distributed mode, rank 0 simulates the controller, switch A, and its
+  // hosts, while rank 1 simulates switch C and its hosts. Links crossing
+  // ranks are point-to-point links whose delay is the lookahead between them.
+  uint32_t systemIdC = 0;
+  if (distributed)
+    {
+#ifdef NS3_MPI
+      NS_ABORT_MSG_IF (replicas > 1 || !warmUp.IsZero (),
+                       "Distributed mode can't fork replications or variants.");
+      NS_ABORT_MSG_IF (linkDelay.IsZero (),
+                       "Distributed mode requires a non-zero link delay.");
+      GlobalValue::Bind ("SimulatorImplementationType",
+                         StringValue ("ns3::DistributedSimulatorImpl"));
+      MpiInterface::Enable (&argc, &argv);
+      NS_ABORT_MSG_IF (MpiInterface::GetSize () != 2,
+                       "Distributed mode requires exactly two MPI ranks.");
+      systemIdC = 1;
+      Config::SetDefault ("ns3::PointToPointChannel::Delay",
+                          TimeValue (linkDelay));
+
+      // Each rank writes its own output files.
+      outputPrefix << "r" << MpiInterface::GetSystemId () << "-";
+      Config::SetGlobal ("OutputPrefix", StringValue (outputPrefix.str ()));
+#else
+      NS_ABORT_MSG ("Distributed mode requires ns-3 built with MPI support.");
+#endif
+    }
+
 
   // --------------------------------------------------------------------------
   // Configuring the OpenFlow network with three switches in line.
@@ -147,10 +224,34 @@ main (int argc, char *argv[])
   Ptr<OFSwitch13InternalHelper> of13Helper = CreateObject<OFSwitch13InternalHelper>();
   of13Helper->SetDeviceAttribute ("PipelineTables", UintegerValue (OFS_TAB_TOTAL));
 
+  // In distributed mode, every rank creates the same nodes, links, and
+  // switch devices, keeping node IDs, device indexes, and datapath IDs equal
+  // across ranks. Only the rank owning the controller or a switch starts it,
+  // connects it, and monitors it. Switches simulated by other ranks are
+  // installed by a helper that never connects them nor enables statistics.
+  Ptr<OFSwitch13InternalHelper> remoteHelper = CreateObject<OFSwitch13InternalHelper>();
+  remoteHelper->SetDeviceAttribute ("PipelineTables", UintegerValue (OFS_TAB_TOTAL));
+
   // Create the controller node and configure it.
   Ptr<Node> controllerNode = CreateObject<Node> ();
   Ptr<Controller> controllerApp = CreateObject<Controller>();
-  of13Helper->InstallController (controllerNode, controllerApp);
+  bool localController =
+    controllerNode->GetSystemId () == Simulator::GetSystemId ();
+  if (!distributed)
+    {
+      of13Helper->InstallController (controllerNode, controllerApp);
+    }
+
+  // Dynamic slicing needs the link usage in both directions, but each rank
+  // only sees the traffic sent by its own switch.
+  EnumValue sliceModeValue;
+  controllerApp->GetAttribute ("SliceMode", sliceModeValue);
+  NS_ABORT_MSG_IF (distributed && sliceModeValue.Get () == SliceMode::DYNA,
+                   "Dynamic slicing is not supported in distributed mode.");
+
+  // With static ARP, hosts get permanent ARP entries and switches drop ARP.
+  EnumValue staticArpValue;
+  controllerApp->GetAttribute ("StaticArp", staticArpValue);
 
   //Set scenario queues
   // switch(controllerApp->GetScenarioConfig()){
@@ -172,12 +273,18 @@ main (int argc, char *argv[])
 
   // Create the switch nodes and configure them.
   NodeContainer switchNodes;
-  switchNodes.Create (2);
+  switchNodes.Create (1);
+  switchNodes.Create (1, systemIdC);
   Names::Add ("A", switchNodes.Get (0));
   Names::Add ("C", switchNodes.Get (1));
 
   OFSwitch13DeviceContainer switchDevices;
-  switchDevices = of13Helper->InstallSwitch (switchNodes);
+  for (NodeContainer::Iterator it = switchNodes.Begin ();
+       it != switchNodes.End (); ++it)
+    {
+      bool local = (*it)->GetSystemId () == Simulator::GetSystemId ();
+      switchDevices.Add ((local ? of13Helper : remoteHelper)->InstallSwitch (*it));
+    }
   PortsList_t switchPorts;
 
   CsmaHelper csmaHelper;
@@ -185,30 +292,70 @@ main (int argc, char *argv[])
   csmaHelper.SetChannelAttribute ("Delay", TimeValue (MilliSeconds (0)));
 
   // Connect switch A to switch C
+  PointToPointHelper p2pHelper;
+  p2pHelper.SetChannelAttribute ("Delay", TimeValue (linkDelay));
   NetDeviceContainer pairDevs;
-  pairDevs = csmaHelper.Install (switchNodes.Get (0), switchNodes.Get (1));
+  if (distributed)
+    {
+      p2pHelper.SetDeviceAttribute ("DataRate", DataRateValue (DataRate ("160Mbps")));
+      pairDevs = p2pHelper.Install (switchNodes.Get (0), switchNodes.Get (1));
+    }
+  else
+    {
+      pairDevs = csmaHelper.Install (switchNodes.Get (0), switchNodes.Get (1));
+    }
   switchPorts.push_back (switchDevices.Get (0)->AddSwitchPort (pairDevs.Get (0)));
   switchPorts.push_back (switchDevices.Get (1)->AddSwitchPort (pairDevs.Get (1)));
+  NetDeviceContainer switchLinkDevs = pairDevs;
   CreateObject<LinkInfo> (switchPorts.at (0), switchPorts.at (1),
-                          DynamicCast<CsmaChannel> (pairDevs.Get (0)->GetChannel ()));
+                          pairDevs.Get (0)->GetChannel ());
 
 
-  // Create the OpenFlow channel.
-  of13Helper->CreateOpenFlowChannels ();
-
-  // Enable OpenFlow switch statistics.
-  of13Helper->EnableDatapathStats (outputPrefix.str () + "switch-stats", true);
-
-  // PCAP tracing on the OpenFlow network only.
-  if (trace)
+  // Create the OpenFlow channel. In distributed mode, each switch gets a
+  // dedicated point-to-point link to the controller, like the helper does,
+  // but only the rank owning the switch starts its connection.
+  NetDeviceContainer ctrlLinkDevs;
+  if (distributed)
     {
-      std::string pcapPrefix = outputPrefix.str ();
-      csmaHelper.EnablePcap (pcapPrefix + "sw", switchNodes, true);
-      of13Helper->EnableOpenFlowPcap (pcapPrefix + "crtl", true);
+      InternetStackHelper ctrlInternet;
+      ctrlInternet.Install (controllerNode);
+      ctrlInternet.Install (switchNodes);
+
+      DataRateValue ctrlRateValue;
+      of13Helper->GetAttribute ("ChannelDataRate", ctrlRateValue);
+      p2pHelper.SetDeviceAttribute ("DataRate", ctrlRateValue);
+      UintegerValue ctrlPortValue;
+      controllerApp->GetAttribute ("Port", ctrlPortValue);
+
+      Ipv4AddressHelper ctrlAddrHelper ("10.100.0.0", "255.255.255.252");
+      for (uint32_t i = 0; i < switchNodes.GetN (); i++)
+        {
+          NetDeviceContainer devs;
+          devs = p2pHelper.Install (controllerNode, switchNodes.Get (i));
+          Ipv4InterfaceContainer ifaces = ctrlAddrHelper.Assign (devs);
+          ctrlAddrHelper.NewNetwork ();
+          ctrlLinkDevs.Add (devs);
+          if (switchNodes.Get (i)->GetSystemId () == Simulator::GetSystemId ())
+            {
+              switchDevices.Get (i)->StartControllerConnection (
+                InetSocketAddress (ifaces.GetAddress (0), ctrlPortValue.Get ()));
+            }
+        }
+      if (localController)
+        {
+          controllerNode->AddApplication (controllerApp);
+        }
+    }
+  else
+    {
+      of13Helper->CreateOpenFlowChannels ();
     }
 
   // Notify the controler about the OpenFlow switches.
-  controllerApp->NotifySwitches (switchDevices, switchPorts);
+  if (localController)
+    {
+      controllerApp->NotifySwitches (switchDevices, switchPorts);
+    }
 
   // --------------------------------------------------------------------------
   // Configuring the network slices
@@ -231,11 +378,23 @@ main (int argc, char *argv[])
   Ipv4InterfaceContainer serverIpIFaces;
   Ipv4InterfaceContainer hostsIpIFaces;
 
+  // Hosts and addresses for each slice, used to install the applications
+  // after forking the replications.
+  struct SliceHosts
+  {
+    Ptr<SliceInfo>          slice;
+    NodeContainer           hostsA, hostsC;
+    Ipv4InterfaceContainer  ipIfacesA, ipIfacesC;
+  };
+  std::vector<SliceHosts> sliceHosts;
+
+  uint32_t slcLine = 0;
   while (!slcFile.eof ())
     {
       // Read the next non-empty line from file.
       std::string lineBuffer;
       getline (slcFile, lineBuffer);
+      slcLine++;
       if (lineBuffer.empty ())
         {
           continue;
@@ -268,7 +427,7 @@ main (int argc, char *argv[])
 
       // Create the host nodes.
       hostsA.Create (slice->GetNumHostsA ());
-      hostsC.Create (slice->GetNumHostsC ());
+      hostsC.Create (slice->GetNumHostsC (), systemIdC);
 
       hosts.Add(hostsA);
       servers.Add(hostsC);
@@ -288,77 +447,239 @@ main (int argc, char *argv[])
           switchPortsC.push_back (switchDevices.Get (1)->AddSwitchPort (pairDevs.Get (1)));
         }
 
-      // Install the TCP/IP stack into hosts nodes
-      InternetStackHelper internet;
-      internet.Install (hostsA);
-      internet.Install (hostsC);
-
       // Configure the base addresses
       std::string sliceId = std::to_string (slice->GetSliceId ());
       std::string hostsAddrA = "0." + sliceId + ".1.1";
       std::string hostsAddrC  = "0." + sliceId + ".2.1";
       Ipv4Address baseAddressA (hostsAddrA.c_str ());
       Ipv4Address baseAddressC (hostsAddrC.c_str ());
-
-      // Set IPv4 host addresses.
-      // Hosts on switches A with IP address 10.SLICEID.1.HOSTNUM
       Ipv4AddressHelper ipv4Helper;
-      ipv4Helper.SetBase ("10.0.0.0", "255.0.0.0", baseAddressA);
-      hostIpIfacesA = ipv4Helper.Assign (hostDevicesA);
-      hostsIpIFaces.Add(hostIpIfacesA);
-
-      // Hosts on switch C with IP address 10.SLICEID.2.HOSTNUM
-      ipv4Helper.SetBase ("10.0.0.0", "255.0.0.0", baseAddressC);
-      hostIpIfacesC = ipv4Helper.Assign (hostDevicesC);
-      serverIpIFaces.Add(hostIpIfacesC);
 
-      // Notify controller about host connections
-      for (size_t i = 0; i < hostsA.GetN (); i++)
+      if (slice->GetLightHosts ())
         {
-          controllerApp->NotifyHost (switchPortsA.at (i), hostDevicesA.Get (i));
+          // Install the lightweight UDP-only stack into hosts nodes and set
+          // IPv4 host addresses as below, without the default queue discs.
+          LightStackHelper lightStack;
+          lightStack.Install (hostsA);
+          lightStack.Install (hostsC);
+
+          Ipv4Mask hostsMask ("255.0.0.0");
+          ipv4Helper.SetBase ("10.0.0.0", hostsMask, baseAddressA);
+          hostIpIfacesA = lightStack.Assign (hostDevicesA, ipv4Helper, hostsMask);
+          hostsIpIFaces.Add (hostIpIfacesA);
+          ipv4Helper.SetBase ("10.0.0.0", hostsMask, baseAddressC);
+          hostIpIfacesC = lightStack.Assign (hostDevicesC, ipv4Helper, hostsMask);
+          serverIpIFaces.Add (hostIpIfacesC);
         }
-      
-      for (size_t i = 0; i < hostsC.GetN (); i++)
+      else
         {
-          controllerApp->NotifyHost (switchPortsC.at (i), hostDevicesC.Get (i));
+          // Install the TCP/IP stack into hosts nodes
+          InternetStackHelper internet;
+          internet.Install (hostsA);
+          internet.Install (hostsC);
+
+          // Set IPv4 host addresses.
+          // Hosts on switches A with IP address 10.SLICEID.1.HOSTNUM
+          ipv4Helper.SetBase ("10.0.0.0", "255.0.0.0", baseAddressA);
+          hostIpIfacesA = ipv4Helper.Assign (hostDevicesA);
+          hostsIpIFaces.Add(hostIpIfacesA);
+
+          // Hosts on switch C with IP address 10.SLICEID.2.HOSTNUM
+          ipv4Helper.SetBase ("10.0.0.0", "255.0.0.0", baseAddressC);
+          hostIpIfacesC = ipv4Helper.Assign (hostDevicesC);
+          serverIpIFaces.Add(hostIpIfacesC);
         }
 
-      //Create the applications helpers based on the params 'AppsConfig'
-      slice->createAppHelpers();
+      // Apps only talk between hosts A and C with the same index, so each
+      // host gets a permanent ARP entry only for its peer. This is required
+      // when switches drop ARP packets, and saves the ARP resolution
+      // otherwise.
+      if (staticArpValue.Get () == OpMode::ON || slice->GetLightHosts ())
+        {
+          size_t nPairs = std::min (hostsA.GetN (), hostsC.GetN ());
+          for (size_t i = 0; i < nPairs; i++)
+            {
+              LightStackHelper::AddNeighbor (
+                hostIpIfacesA.Get (i), hostIpIfacesC.GetAddress (i),
+                hostDevicesC.Get (i)->GetAddress ());
+              LightStackHelper::AddNeighbor (
+                hostIpIfacesC.Get (i), hostIpIfacesA.GetAddress (i),
+                hostDevicesA.Get (i)->GetAddress ());
+            }
+        }
 
-      std::vector<Ptr<UdpPeerHelper>> appHelpers = slice->GetAppHelpers();
-      for(size_t i = 0; i < appHelpers.size(); i++){
-        appHelpers[i]->Install (hostsA, hostsC, hostIpIfacesA, hostIpIfacesC, slice->GetSliceId ());
-        // appHelpers[i]->SetBothAttribute ("SliceId", UintegerValue (slice->GetSliceId ()));
-      }
-      
+      // Notify controller about host connections
+      if (localController)
+        {
+          for (size_t i = 0; i < hostsA.GetN (); i++)
+            {
+              controllerApp->NotifyHost (switchPortsA.at (i), hostDevicesA.Get (i));
+            }
+
+          for (size_t i = 0; i < hostsC.GetN (); i++)
+            {
+              controllerApp->NotifyHost (switchPortsC.at (i), hostDevicesC.Get (i));
+            }
+        }
+
+      // Parse the applications configuration from the params 'AppsConfig'.
+      // With replications, the applications are installed later for each
+      // RngRun. Otherwise, install them now to keep the random streams.
+      size_t cfgPos = lineBuffer.find ("AppsConfig=");
+      slice->parseAppsConfig (
+        slcFilename, slcLine,
+        cfgPos == std::string::npos ? 1 : cfgPos + 12);
+      if (replicas > 1)
+        {
+          sliceHosts.push_back (
+            {slice, hostsA, hostsC, hostIpIfacesA, hostIpIfacesC});
+          continue;
+        }
+      slice->createAppHelpers ();
+      for (auto const &appHelper : slice->GetAppHelpers ())
+        {
+          appHelper->Install (hostsA, hostsC, hostIpIfacesA, hostIpIfacesC,
+                              slice->GetSliceId ());
+        }
     }
   slcFile.close ();
 
 
   // Notify the controler about the network slices.
-  controllerApp->NotifySlices (SliceInfo::GetList ());
+  if (localController)
+    {
+      controllerApp->NotifySlices (SliceInfo::GetList ());
+    }
+
+
+  // --------------------------------------------------------------------------
+  // Replicating the simulation
+  // --------------------------------------------------------------------------
+  // The network setup above does not depend on the RngRun, so replications
+  // share it by forking this process once for each RngRun value. Random
+  // variables created before the fork keep the streams of the first run.
+  if (replicas > 1)
+    {
+      uint32_t firstRun = RngSeedManager::GetRun ();
+      uint32_t replica;
+      int failed = ForkChildren (replicas, maxParallel, replica);
+      if (failed >= 0)
+        {
+          // The parent process only waits for all replications.
+          std::cout << "END " << replicas << " REPLICATIONS";
+          if (failed)
+            {
+              std::cout << " - " << failed << " FAILED";
+            }
+          std::cout << std::endl;
+          return failed ? 1 : 0;
+        }
+
+      RngSeedManager::SetRun (firstRun + replica);
+      outputPrefix.str ("");
+      outputPrefix << inputPrefix.str () << RngSeedManager::GetRun () << "-";
+      Config::SetGlobal ("OutputPrefix", StringValue (outputPrefix.str ()));
+    }
 
+  // Install the applications for this RngRun, when deferred.
+  for (auto const &sh : sliceHosts)
+    {
+      sh.slice->createAppHelpers ();
+      for (auto const &appHelper : sh.slice->GetAppHelpers ())
+        {
+          appHelper->Install (sh.hostsA, sh.hostsC, sh.ipIfacesA,
+                              sh.ipIfacesC, sh.slice->GetSliceId ());
+        }
+    }
 
   // --------------------------------------------------------------------------
   // Simulating the network
   // --------------------------------------------------------------------------
   NS_LOG_INFO ("Simulating...");
   EnableProgress (progress);
-
-  // Create the network statistics object for bandwidth and traffic monitoring.
-  Ptr<NetworkStatistics> statistics = CreateObject<NetworkStatistics> ();
+  if (profile)
+    {
+      RuntimeProfiler::Enable (Seconds (progress));
+    }
 
   TimeValue timeValue;
   GlobalValue::GetValueByName ("SimTime", timeValue);
   Time stopAt = timeValue.Get () + MilliSeconds (100);
 
-  Simulator::Stop (stopAt);
-  Simulator::Run ();
+  // In what-if mode, simulate the warm-up period only once and then fork the
+  // process to run each controller variant from the same network state.
+  // Output files are only created after the fork, so statistics for each
+  // variant start at the end of the warm-up period.
+  if (!warmUp.IsZero ())
+    {
+      NS_ASSERT_MSG (warmUp < stopAt, "Warm-up time after simulation end.");
+      std::vector<std::string> variantList;
+      std::istringstream variantStream (variants);
+      std::string variantStr;
+      while (std::getline (variantStream, variantStr, ';'))
+        {
+          variantList.push_back (variantStr);
+        }
+      NS_ASSERT_MSG (!variantList.empty (), "No what-if variants.");
 
+      Simulator::Stop (warmUp);
+      Simulator::Run ();
+
+      uint32_t variant;
+      int failed = ForkChildren (variantList.size (), maxParallel, variant);
+      if (failed >= 0)
+        {
+          // The parent process only waits for all variants.
+          std::cout << "END " << variantList.size () << " VARIANTS";
+          if (failed)
+            {
+              std::cout << " - " << failed << " FAILED";
+            }
+          std::cout << std::endl;
+          return failed ? 1 : 0;
+        }
+
+      std::cout << "Variant " << variant << ": "
+                << variantList [variant] << std::endl;
+      ApplyVariant (controllerApp, variantList [variant]);
+      outputPrefix << "v" << variant << "-";
+      Config::SetGlobal ("OutputPrefix", StringValue (outputPrefix.str ()));
+    }
+
+  // Enable OpenFlow switch statistics.
+  of13Helper->EnableDatapathStats (outputPrefix.str () + "switch-stats", true);
+
+  // PCAP tracing on the OpenFlow network only.
+  if (trace)
+    {
+      std::string pcapPrefix = outputPrefix.str ();
+      if (distributed)
+        {
+          p2pHelper.EnablePcap (pcapPrefix + "sw", switchLinkDevs, true);
+          p2pHelper.EnablePcap (pcapPrefix + "crtl", ctrlLinkDevs, true);
+        }
+      else
+        {
+          csmaHelper.EnablePcap (pcapPrefix + "sw", switchLinkDevs, true);
+          of13Helper->EnableOpenFlowPcap (pcapPrefix + "crtl", true);
+        }
+    }
+
+  // Create the network statistics object for bandwidth and traffic monitoring.
+  Ptr<NetworkStatistics> statistics = CreateObject<NetworkStatistics> ();
+
+  Simulator::Stop (stopAt - Simulator::Now ());
+  Simulator::Run ();
+  RuntimeProfiler::PrintReport (std::cout);
 
   // Finish the simulation.
   Simulator::Destroy ();
+#ifdef NS3_MPI
+  if (distributed)
+    {
+      MpiInterface::Disable ();
+    }
+#endif
 
   // Closing output statistic files.
   statistics->Dispose ();
@@ -460,14 +781,19 @@ EnableVerbose (bool enable)
       LogComponentEnable ("Common",                   logLevelAll);
 
       // Applications
+      LogComponentEnable ("ElasticHeader",            logLevelWarn);
+      LogComponentEnable ("DemandProfile",            logLevelWarn);
+      LogComponentEnable ("UdpAggregateApp",          logLevelWarn);
       LogComponentEnable ("UdpPeerApp",               logLevelWarn);
       LogComponentEnable ("UdpPeerHelper",            logLevelWarnInfo);
 
       // Infrastructure
       LogComponentEnable ("Controller",               logLevelAll);
+      LogComponentEnable ("LightStackHelper",         logLevelWarn);
       LogComponentEnable ("QosQueue",                 logLevelWarn);
 
       // Metadata
+      LogComponentEnable ("AppsConfigParser",         logLevelWarn);
       LogComponentEnable ("LinkInfo",                 logLevelWarn);
       LogComponentEnable ("SliceInfo",                logLevelWarn);
       LogComponentEnable ("SliceTag",                 logLevelWarn);
@@ -494,3 +820,91 @@ EnableOfsLogs (bool enable)
       ofs::EnableLibraryLog (true, prefix);
     }
 }
+
+int
+ForkChildren (uint32_t count, uint32_t maxParallel, uint32_t &index)
+{
+  if (maxParallel == 0)
+    {
+      long cpus = sysconf (_SC_NPROCESSORS_ONLN);
+      maxParallel = cpus > 0 ? cpus : 1;
+    }
+
+  // Wait for any child to finish, counting it when it failed.
+  int failed = 0;
+  auto waitChild = [&failed] ()
+    {
+      int status;
+      pid_t pid = waitpid (-1, &status, 0);
+      NS_ABORT_MSG_IF (pid < 0, "Can't wait for child processes.");
+      if (!WIFEXITED (status) || WEXITSTATUS (status) != 0)
+        {
+          failed++;
+        }
+    };
+
+  // Flush pending output so children don't print it again.
+  std::cout.flush ();
+  uint32_t running = 0;
+  for (uint32_t i = 0; i < count; i++)
+    {
+      if (running == maxParallel)
+        {
+          waitChild ();
+          running--;
+        }
+
+      pid_t pid = fork ();
+      NS_ABORT_MSG_IF (pid < 0, "Can't fork child process " << i);
+      if (pid == 0)
+        {
+          index = i;
+          return -1;
+        }
+      running++;
+    }
+
+  for (; running; running--)
+    {
+      waitChild ();
+    }
+  return failed;
+}
+
+void
+ApplyVariant (Ptr<Controller> controller, std::string variant)
+{
+  std::istringstream variantStream (variant);
+  std::string assignment;
+  while (std::getline (variantStream, assignment, ','))
+    {
+      size_t pos = assignment.find ('=');
+      NS_ABORT_MSG_IF (pos == std::string::npos,
+                       "Invalid what-if assignment " << assignment);
+      std::string name = assignment.substr (0, pos);
+      std::string value = assignment.substr (pos + 1);
+
+      // The slice mode can't be set as an attribute after construction.
+      if (name == "SliceMode")
+        {
+          bool found = false;
+          for (auto mode : {SliceMode::NONE, SliceMode::SHAR,
+                            SliceMode::STAT, SliceMode::DYNA})
+            {
+              if (value == SliceModeStr (mode))
+                {
+                  controller->ChangeSliceMode (mode);
+                  found = true;
+                }
+            }
+          NS_ABORT_MSG_IF (!found, "Invalid slice mode " << value);
+        }
+      else
+        {
+          controller->SetAttribute (name, StringValue (value));
+        }
+    }
+
+  // Apply the new values now instead of waiting for the next slicing event.
+  controller->ReapplySlicing ();
+}
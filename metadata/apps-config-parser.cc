@@ -0,0 +1,538 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Thiago Guimarães <thiago.guimaraes@ice.ufjf.br>
+ *         Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include "apps-config-parser.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("AppsConfigParser");
+
+// Number of mandatory fields in each application configuration.
+#define N_MANDATORY_FIELDS 9
+
+const char* const AppsConfigParser::m_fieldNames [N_FIELDS] = {
+  "NumApps", "DataRate", "StartInterval", "StartOffset", "TrafficLength",
+  "FullDuplex", "SplitTraffic", "DSCP", "TQosType", "Elastic", "DemandProfile"
+};
+
+AppConfig::AppConfig ()
+  : numApps (1),
+  dataRate (1024),
+  startInterval (30),
+  startOffset (0),
+  trafficLength (30),
+  fullDuplex (false),
+  split (false),
+  dscp (Ipv4Header::DscpDefault),
+  tQosType (TQosType::BE),
+  elastic (false)
+{
+}
+
+AppsConfigParser::AppsConfigParser (std::string source, uint32_t line,
+                                    uint32_t column)
+  : m_source (source),
+  m_firstLine (line),
+  m_firstCol (column),
+  m_pos (0),
+  m_end (0),
+  m_line (line),
+  m_col (column)
+{
+  NS_LOG_FUNCTION (this << source << line << column);
+}
+
+std::vector<AppConfig>
+AppsConfigParser::ParseCompact (const std::string &text)
+{
+  NS_LOG_FUNCTION (this);
+
+  std::vector<AppConfig> configs;
+  Reset (text);
+  SkipBlanks ();
+  Expect ('(');
+  while (true)
+    {
+      SkipBlanks ();
+      if (Accept (')'))
+        {
+          break;
+        }
+      if (Peek () != '{')
+        {
+          Fail ("expected '{' or ')'");
+        }
+      configs.push_back (ParseApp (false));
+      SkipBlanks ();
+      if (!Accept (';'))
+        {
+          SkipBlanks ();
+          Expect (')');
+          break;
+        }
+    }
+  SkipBlanks ();
+  if (!AtEnd ())
+    {
+      Fail ("unexpected characters after ')'");
+    }
+  return configs;
+}
+
+std::vector<AppConfig>
+AppsConfigParser::ParseJson (const std::string &text)
+{
+  NS_LOG_FUNCTION (this);
+
+  std::vector<AppConfig> configs;
+  Reset (text);
+  SkipBlanks ();
+  Expect ('[');
+  SkipBlanks ();
+  if (!Accept (']'))
+    {
+      do
+        {
+          SkipBlanks ();
+          configs.push_back (ParseApp (true));
+          SkipBlanks ();
+        }
+      while (Accept (','));
+      Expect (']');
+    }
+  SkipBlanks ();
+  if (!AtEnd ())
+    {
+      Fail ("unexpected characters after ']'");
+    }
+  return configs;
+}
+
+std::vector<AppConfig>
+AppsConfigParser::LoadJsonFile (std::string filename)
+{
+  NS_LOG_FUNCTION (filename);
+
+  std::ifstream file (filename.c_str (), std::ifstream::in);
+  NS_ABORT_MSG_IF (!file.good (), "Can't open apps config file " << filename);
+  std::stringstream buffer;
+  buffer << file.rdbuf ();
+
+  AppsConfigParser parser (filename);
+  return parser.ParseJson (buffer.str ());
+}
+
+void
+AppsConfigParser::Reset (const std::string &text)
+{
+  m_pos = text.c_str ();
+  m_end = m_pos + text.size ();
+  m_line = m_firstLine;
+  m_col = m_firstCol;
+}
+
+bool
+AppsConfigParser::AtEnd (void) const
+{
+  return m_pos == m_end;
+}
+
+char
+AppsConfigParser::Peek (void) const
+{
+  return AtEnd () ? '\0' : *m_pos;
+}
+
+void
+AppsConfigParser::Advance (size_t count)
+{
+  for (size_t i = 0; i < count && !AtEnd (); i++, m_pos++)
+    {
+      if (*m_pos == '\n')
+        {
+          m_line++;
+          m_col = 1;
+        }
+      else
+        {
+          m_col++;
+        }
+    }
+}
+
+void
+AppsConfigParser::SkipBlanks (void)
+{
+  while (!AtEnd () && std::isspace (static_cast<unsigned char> (*m_pos)))
+    {
+      Advance ();
+    }
+}
+
+bool
+AppsConfigParser::Accept (char c)
+{
+  if (Peek () == c && !AtEnd ())
+    {
+      Advance ();
+      return true;
+    }
+  return false;
+}
+
+void
+AppsConfigParser::Expect (char c)
+{
+  if (!Accept (c))
+    {
+      Fail (std::string ("expected '") + c + "'" + (AtEnd () ?
+                                                    " before end of input" :
+                                                    std::string (" but found '")
+                                                    + Peek () + "'"));
+    }
+}
+
+AppConfig
+AppsConfigParser::ParseApp (bool json)
+{
+  AppConfig config;
+  bool seen [N_FIELDS] = {};
+  uint32_t appLine = m_line;
+  uint32_t appCol = m_col;
+
+  Expect ('{');
+  if (json)
+    {
+      SkipBlanks ();
+      if (!Accept ('}'))
+        {
+          do
+            {
+              SkipBlanks ();
+              uint32_t keyLine = m_line;
+              uint32_t keyCol = m_col;
+              std::string key = ParseJsonString ();
+              int field = 0;
+              while (field < N_FIELDS && key != m_fieldNames [field])
+                {
+                  field++;
+                }
+              if (field == N_FIELDS || seen [field])
+                {
+                  m_line = keyLine;
+                  m_col = keyCol;
+                  Fail ((field == N_FIELDS ? "unknown field \"" :
+                         "duplicated field \"") + key + "\"");
+                }
+              SkipBlanks ();
+              Expect (':');
+              SkipBlanks ();
+              ParseField (config, static_cast<Field> (field), true);
+              seen [field] = true;
+              SkipBlanks ();
+            }
+          while (Accept (','));
+          Expect ('}');
+        }
+    }
+  else
+    {
+      // Positional fields, with an optional trailing comma.
+      int field = 0;
+      while (true)
+        {
+          SkipBlanks ();
+          if (Accept ('}'))
+            {
+              break;
+            }
+          if (field == N_FIELDS)
+            {
+              Fail ("too many fields in application configuration");
+            }
+          ParseField (config, static_cast<Field> (field), false);
+          seen [field++] = true;
+          SkipBlanks ();
+          if (!Accept (','))
+            {
+              Expect ('}');
+              break;
+            }
+        }
+    }
+
+  for (int field = 0; field < N_MANDATORY_FIELDS; field++)
+    {
+      if (!seen [field])
+        {
+          m_line = appLine;
+          m_col = appCol;
+          Fail (std::string ("missing field ") + m_fieldNames [field] +
+                " in application configuration");
+        }
+    }
+
+  NS_LOG_INFO ("Apps config: NumApps=" << config.numApps <<
+               " DataRate=" << config.dataRate <<
+               " StartInterval=" << config.startInterval <<
+               " StartOffset=" << config.startOffset <<
+               " TrafficLength=" << config.trafficLength <<
+               " FullDuplex=" << config.fullDuplex <<
+               " SplitTraffic=" << config.split <<
+               " DSCP=" << config.dscp <<
+               " TQosType=" << TQosTypeStr (config.tQosType) <<
+               " Elastic=" << config.elastic <<
+               " DemandProfile=" << config.profile);
+  return config;
+}
+
+void
+AppsConfigParser::ParseField (AppConfig &config, Field field, bool json)
+{
+  switch (field)
+    {
+    case NUM_APPS:
+      config.numApps = ParseInteger (0xFFFF);
+      break;
+    case DATA_RATE:
+      config.dataRate = ParseNumber ();
+      break;
+    case START_INTERVAL:
+      config.startInterval = ParseNumber ();
+      break;
+    case START_OFFSET:
+      config.startOffset = ParseNumber ();
+      break;
+    case TRAFFIC_LENGTH:
+      config.trafficLength = ParseNumber ();
+      break;
+    case FULL_DUPLEX:
+      config.fullDuplex = ParseFlag (json);
+      break;
+    case SPLIT_TRAFFIC:
+      config.split = ParseFlag (json);
+      break;
+    case DSCP:
+      {
+        uint32_t line = m_line;
+        uint32_t col = m_col;
+        std::string jsonWord;
+        const char *word;
+        size_t length;
+        if (json)
+          {
+            jsonWord = ParseJsonString ();
+            word = jsonWord.c_str ();
+            length = jsonWord.size ();
+          }
+        else
+          {
+            word = ParseWord (length);
+          }
+
+        static const struct
+        {
+          const char           *name;
+          Ipv4Header::DscpType  dscp;
+        } dscpNames [] = {
+          {"EF",   Ipv4Header::DSCP_EF},
+          {"AF41", Ipv4Header::DSCP_AF41},
+          {"AF31", Ipv4Header::DSCP_AF31},
+          {"AF32", Ipv4Header::DSCP_AF32},
+          {"AF21", Ipv4Header::DSCP_AF21},
+          {"AF11", Ipv4Header::DSCP_AF11},
+          {"BE",   Ipv4Header::DscpDefault}
+        };
+        for (auto const &entry : dscpNames)
+          {
+            if (std::strlen (entry.name) == length
+                && std::strncmp (entry.name, word, length) == 0)
+              {
+                config.dscp = entry.dscp;
+                return;
+              }
+          }
+        m_line = line;
+        m_col = col;
+        Fail ("unknown DSCP '" + std::string (word, length) + "'");
+        break;
+      }
+    case TQOS_TYPE:
+      config.tQosType = static_cast<TQosType> (
+          ParseInteger (N_TRAFFIC_TYPES - 1));
+      break;
+    case ELASTIC:
+      config.elastic = ParseFlag (json);
+      break;
+    case DEMAND_PROFILE:
+      if (json)
+        {
+          config.profile = ParseJsonString ();
+        }
+      else
+        {
+          size_t length;
+          const char *word = ParseWord (length);
+          config.profile.assign (word, length);
+        }
+      break;
+    default:
+      NS_ABORT_MSG ("Invalid field.");
+    }
+}
+
+double
+AppsConfigParser::ParseNumber (void)
+{
+  // The input is a std::string, so strtod always stops before its end.
+  char *end;
+  double value = std::strtod (m_pos, &end);
+  if (end == m_pos || end > m_end || !std::isfinite (value))
+    {
+      Fail ("expected a number");
+    }
+  if (value < 0)
+    {
+      Fail ("expected a non-negative number");
+    }
+  Advance (end - m_pos);
+  return value;
+}
+
+uint32_t
+AppsConfigParser::ParseInteger (uint32_t maxValue)
+{
+  uint32_t line = m_line;
+  uint32_t col = m_col;
+  double value = ParseNumber ();
+  if (value != std::floor (value) || value > maxValue)
+    {
+      m_line = line;
+      m_col = col;
+      std::ostringstream message;
+      message << "expected an integer between 0 and " << maxValue;
+      Fail (message.str ());
+    }
+  return static_cast<uint32_t> (value);
+}
+
+bool
+AppsConfigParser::ParseFlag (bool json)
+{
+  if (json && (Peek () == 't' || Peek () == 'f'))
+    {
+      uint32_t line = m_line;
+      uint32_t col = m_col;
+      size_t length;
+      const char *word = ParseWord (length);
+      if (length == 4 && std::strncmp (word, "true", 4) == 0)
+        {
+          return true;
+        }
+      if (length == 5 && std::strncmp (word, "false", 5) == 0)
+        {
+          return false;
+        }
+      m_line = line;
+      m_col = col;
+      Fail ("expected true or false");
+    }
+  if (Peek () == '0' || Peek () == '1')
+    {
+      bool value = (Peek () == '1');
+      Advance ();
+      return value;
+    }
+  Fail ("expected 0 or 1");
+  return false;
+}
+
+const char*
+AppsConfigParser::ParseWord (size_t &length)
+{
+  const char *start = m_pos;
+  while (!AtEnd () && *m_pos != ',' && *m_pos != '}' && *m_pos != ';'
+         && *m_pos != ')' && *m_pos != ']'
+         && !std::isspace (static_cast<unsigned char> (*m_pos)))
+    {
+      Advance ();
+    }
+  length = m_pos - start;
+  if (!length)
+    {
+      Fail ("expected a value");
+    }
+  return start;
+}
+
+std::string
+AppsConfigParser::ParseJsonString (void)
+{
+  std::string value;
+  Expect ('"');
+  while (!AtEnd () && *m_pos != '"')
+    {
+      char c = *m_pos;
+      if (c == '\n')
+        {
+          Fail ("unterminated string");
+        }
+      if (c == '\\')
+        {
+          Advance ();
+          switch (Peek ())
+            {
+            case '"':
+            case '\\':
+            case '/':
+              c = Peek ();
+              break;
+            case 't':
+              c = '\t';
+              break;
+            case 'n':
+              c = '\n';
+              break;
+            default:
+              Fail ("unsupported escape sequence in string");
+            }
+        }
+      value.push_back (c);
+      Advance ();
+    }
+  Expect ('"');
+  return value;
+}
+
+void
+AppsConfigParser::Fail (std::string message) const
+{
+  NS_ABORT_MSG (m_source << ":" << m_line << ":" << m_col << ": " << message);
+}
+
+} // namespace ns3
@@ -0,0 +1,191 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Thiago Guimarães <thiago.guimaraes@ice.ufjf.br>
+ *         Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+
+#ifndef APPS_CONFIG_PARSER_H
+#define APPS_CONFIG_PARSER_H
+
+#include <vector>
+#include <ns3/core-module.h>
+#include <ns3/internet-module.h>
+#include "../common.h"
+
+namespace ns3 {
+
+/**
+ * The traffic configuration for a group of slice applications, with the
+ * values used to configure one UdpPeerHelper.
+ */
+struct AppConfig
+{
+  AppConfig ();  //!< Default constructor.
+
+  uint16_t              numApps;        //!< Number of apps per host pair.
+  double                dataRate;       //!< Mean data rate [kbps].
+  double                startInterval;  //!< Mean start interval [s].
+  double                startOffset;    //!< Start offset [s].
+  double                trafficLength;  //!< Mean traffic length [s].
+  bool                  fullDuplex;     //!< Traffic in both directions.
+  bool                  split;          //!< Split traffic mode.
+  Ipv4Header::DscpType  dscp;           //!< DSCP type.
+  TQosType              tQosType;       //!< Traffic type.
+  bool                  elastic;        //!< Elastic apps.
+  std::string           profile;        //!< Demand profile string.
+};
+
+/**
+ * This class parses and validates the applications configuration for a
+ * network slice, reporting syntax errors with their line and column. Two
+ * formats are supported. The compact format is the AppsConfig value used in
+ * the .slices files, with positional fields:
+ * \verbatim
+ * ({NumApps, DataRate, StartInterval, StartOffset, TrafficLength,
+ *   FullDuplex, SplitTraffic, DSCP, TQosType[, Elastic[, DemandProfile]],};
+ *  {...};)
+ * \endverbatim
+ * The JSON format is an array of objects using the field names above as keys,
+ * intended for generated configurations with many application groups:
+ * \verbatim
+ * [{"NumApps": 35, "DataRate": 1200, ..., "DSCP": "BE", "TQosType": 0}, ...]
+ * \endverbatim
+ * In both formats, the first nine fields are mandatory. The input is scanned
+ * in a single pass without splitting it into intermediate strings.
+ */
+class AppsConfigParser
+{
+public:
+  /**
+   * Complete constructor.
+   * \param source The input name used in error messages.
+   * \param line The line number of the first input character.
+   * \param column The column number of the first input character.
+   */
+  AppsConfigParser (std::string source, uint32_t line = 1,
+                    uint32_t column = 1);
+
+  /**
+   * Parse the compact AppsConfig format.
+   * \param text The input text.
+   * \return The list of application configurations.
+   */
+  std::vector<AppConfig> ParseCompact (const std::string &text);
+
+  /**
+   * Parse the JSON format.
+   * \param text The input text.
+   * \return The list of application configurations.
+   */
+  std::vector<AppConfig> ParseJson (const std::string &text);
+
+  /**
+   * Read and parse a JSON configuration file.
+   * \param filename The input filename.
+   * \return The list of application configurations.
+   */
+  static std::vector<AppConfig> LoadJsonFile (std::string filename);
+
+private:
+  /** Application configuration fields, in compact format order. */
+  enum Field
+  {
+    NUM_APPS = 0,
+    DATA_RATE,
+    START_INTERVAL,
+    START_OFFSET,
+    TRAFFIC_LENGTH,
+    FULL_DUPLEX,
+    SPLIT_TRAFFIC,
+    DSCP,
+    TQOS_TYPE,
+    ELASTIC,
+    DEMAND_PROFILE,
+    N_FIELDS
+  };
+
+  /**
+   * Start scanning a new input text.
+   * \param text The input text.
+   */
+  void Reset (const std::string &text);
+
+  /**
+   * \name Input scanning methods.
+   * \param c The expected character.
+   * \return The current character or true if the character was consumed.
+   */
+  //\{
+  bool AtEnd (void) const;
+  char Peek (void) const;
+  void Advance (size_t count = 1);
+  void SkipBlanks (void);
+  bool Accept (char c);
+  void Expect (char c);
+  //\}
+
+  /**
+   * Parse a single application configuration.
+   * \param json True for the JSON format.
+   * \return The application configuration.
+   */
+  AppConfig ParseApp (bool json);
+
+  /**
+   * Parse the value for a configuration field.
+   * \param config The configuration to update.
+   * \param field The field to parse.
+   * \param json True for the JSON format.
+   */
+  void ParseField (AppConfig &config, Field field, bool json);
+
+  /**
+   * \name Value parsing methods.
+   * \param maxValue The maximum integer value.
+   * \param json True for the JSON format.
+   * \param length The word length.
+   * \return The parsed value.
+   */
+  //\{
+  double      ParseNumber (void);
+  uint32_t    ParseInteger (uint32_t maxValue);
+  bool        ParseFlag (bool json);
+  const char* ParseWord (size_t &length);
+  std::string ParseJsonString (void);
+  //\}
+
+  /**
+   * Abort the simulation with an error message at the current position.
+   * \param message The error message.
+   */
+  void Fail (std::string message) const;
+
+  std::string   m_source;     //!< Input name.
+  uint32_t      m_firstLine;  //!< Line number of the first character.
+  uint32_t      m_firstCol;   //!< Column number of the first character.
+  const char   *m_pos;        //!< Current input position.
+  const char   *m_end;        //!< End of input.
+  uint32_t      m_line;       //!< Current line number.
+  uint32_t      m_col;        //!< Current column number.
+
+  static const char* const m_fieldNames [N_FIELDS];  //!< Field names.
+};
+
+} // namespace ns3
+#endif /* APPS_CONFIG_PARSER_H */
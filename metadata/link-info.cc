@@ -24,6 +24,7 @@
 #include <iostream>
 #include "link-info.h"
 #include "slice-tag.h"
+#include "../statistics/runtime-profiler.h"
 
 using namespace std;
 
@@ -45,7 +46,7 @@ LinkInfo::LinkInfoMap_t LinkInfo::m_linkInfoByDpIds;
 LinkInfoList_t LinkInfo::m_linkInfoList;
 
 LinkInfo::LinkInfo (Ptr<OFSwitch13Port> port1, Ptr<OFSwitch13Port> port2,
-                    Ptr<CsmaChannel> channel)
+                    Ptr<Channel> channel)
   : m_channel (channel)
 {
   NS_LOG_FUNCTION (this << port1 << port2 << channel);
@@ -54,19 +55,35 @@ LinkInfo::LinkInfo (Ptr<OFSwitch13Port> port1, Ptr<OFSwitch13Port> port2,
   m_ports [1] = port2;
 
   // Asserting internal device order to ensure FWD and BWD indices order.
-  NS_ASSERT_MSG (channel->GetCsmaDevice (0) == GetPortDev (0)
-                 && channel->GetCsmaDevice (1) == GetPortDev (1),
-                 "Invalid device order in csma channel.");
+  NS_ASSERT_MSG (channel->GetDevice (0) == GetPortDev (0)
+                 && channel->GetDevice (1) == GetPortDev (1),
+                 "Invalid device order in link channel.");
+
+  // The csma channel holds the link data rate and duplex mode. Point-to-point
+  // links are always full-duplex, with the data rate set at the devices.
+  Ptr<CsmaChannel> csmaChannel = DynamicCast<CsmaChannel> (channel);
+  if (csmaChannel)
+    {
+      m_linkRate = csmaChannel->GetDataRate ();
+      m_fullDuplex = csmaChannel->IsFullDuplex ();
+    }
+  else
+    {
+      DataRateValue rateValue;
+      GetPortDev (0)->GetAttribute ("DataRate", rateValue);
+      m_linkRate = rateValue.Get ();
+      m_fullDuplex = true;
+    }
 
-  // Asserting full-duplex csma channel.
-  NS_ASSERT_MSG (IsFullDuplexLink (), "Invalid half-duplex csma channel.");
+  // Asserting full-duplex link.
+  NS_ASSERT_MSG (IsFullDuplexLink (), "Invalid half-duplex link.");
 
   // Validate maximum bit rate for this implementation.
-  uint64_t link = m_channel->GetDataRate ().GetBitRate ();
+  uint64_t link = m_linkRate.GetBitRate ();
   uint64_t maxr = static_cast<uint64_t> (std::numeric_limits<int64_t>::max ());
   NS_ASSERT_MSG (link < maxr, "Invalid bit rate for this implementation.");
 
-  // Connecting trace source to CsmaNetDevice PhyTxEnd trace source, used to
+  // Connecting trace source to the device PhyTxEnd trace source, used to
   // monitor data transmitted over this connection.
   GetPortDev (0)->TraceConnect (
     "PhyTxEnd", "Forward", MakeCallback (&LinkInfo::NotifyTxPacket, this));
@@ -110,6 +127,10 @@ LinkInfo::GetTypeId (void)
                    TimeValue (MilliSeconds (100)),
                    MakeTimeAccessor (&LinkInfo::m_ewmaTimeout),
                    MakeTimeChecker ())
+
+    .AddTraceSource ("ExtBitRate", "Trace source for extra bit rate updates.",
+                     MakeTraceSourceAccessor (&LinkInfo::m_extraTrace),
+                     "ns3::LinkInfo::ExtraTracedCallback")
   ;
   return tid;
 }
@@ -120,10 +141,10 @@ LinkInfo::GetPortAddr (uint8_t idx) const
   return Mac48Address::ConvertFrom (GetPortDev (idx)->GetAddress ());
 }
 
-Ptr<CsmaNetDevice>
+Ptr<NetDevice>
 LinkInfo::GetPortDev (uint8_t idx) const
 {
-  return DynamicCast<CsmaNetDevice> (GetSwPort (idx)->GetPortDevice ());
+  return GetSwPort (idx)->GetPortDevice ();
 }
 
 uint32_t
@@ -173,7 +194,7 @@ LinkInfo::IsFullDuplexLink (void) const
 {
   NS_LOG_FUNCTION (this);
 
-  return m_channel->IsFullDuplex ();
+  return m_fullDuplex;
 }
 
 int64_t
@@ -181,7 +202,7 @@ LinkInfo::GetLinkBitRate (void) const
 {
   NS_LOG_FUNCTION (this);
 
-  return static_cast<int64_t> (m_channel->GetDataRate ().GetBitRate ());
+  return static_cast<int64_t> (m_linkRate.GetBitRate ());
 }
 
 int
@@ -291,31 +312,36 @@ LinkInfo::HasBitRate (LinkDir dir, int slice, int64_t bitRate,
   return (resBitRate + bitRate <= std::min (blkBitRate, quoBitRate));
 }
 
+void
+LinkInfo::GetValues (LinkDir dir, int slice, int64_t *values) const
+{
+  NS_LOG_FUNCTION (this << dir << slice);
+
+  *values++ = static_cast<int64_t> (GetSwDpId (0));
+  *values++ = static_cast<int64_t> (GetSwDpId (1));
+  *values++ = GetLinkBitRate ();
+  *values++ = GetQuota (dir, slice);
+  *values++ = GetQuoBitRate (dir, slice);
+  *values++ = GetExtBitRate (dir, slice);
+  *values++ = GetMaxBitRate (dir, slice);
+  *values++ = GetResBitRate (dir, slice);
+  *values++ = GetUnrBitRate (dir, slice);
+  *values++ = GetMetBitRate (dir, slice);
+  *values++ = GetUseBitRate (dir, slice, TQosType::AF);
+  *values++ = GetUseBitRate (dir, slice, TQosType::BE);
+  *values++ = GetUseBitRate (dir, slice, TQosType::PRIO);
+  *values++ = GetOveBitRate (dir, slice);
+  *values++ = GetIdlBitRate (dir, slice);
+}
+
 std::ostream &
 LinkInfo::PrintValues (std::ostream &os, LinkDir dir, int slice) const
 {
   NS_LOG_FUNCTION (this);
 
-  std::string linkDescStr;
-  linkDescStr += std::to_string (GetSwDpId (0));
-  linkDescStr += "->";
-  linkDescStr += std::to_string (GetSwDpId (1));
-
-  os << " " << setw (9)  << linkDescStr
-     << " " << setw (11) << Bps2Kbps (GetLinkBitRate ())
-     << " " << setw (8)  << GetQuota (dir, slice)
-     << " " << setw (11) << Bps2Kbps (GetQuoBitRate (dir, slice))
-     << " " << setw (11) << Bps2Kbps (GetExtBitRate (dir, slice))
-     << " " << setw (11) << Bps2Kbps (GetMaxBitRate (dir, slice))
-     << " " << setw (11) << Bps2Kbps (GetResBitRate (dir, slice))
-     << " " << setw (11) << Bps2Kbps (GetUnrBitRate (dir, slice))
-     << " " << setw (11) << Bps2Kbps (GetMetBitRate (dir, slice))
-     << " " << setw (11) << Bps2Kbps (GetUseBitRate (dir, slice, TQosType::AF))
-     << " " << setw (11) << Bps2Kbps (GetUseBitRate (dir, slice, TQosType::BE))
-     << " " << setw (11) << Bps2Kbps (GetUseBitRate (dir, slice, TQosType::PRIO))
-     << " " << setw (11) << Bps2Kbps (GetOveBitRate (dir, slice))
-     << " " << setw (11) << Bps2Kbps (GetIdlBitRate (dir, slice));
-  return os;
+  int64_t values [N_LINK_VALUES];
+  GetValues (dir, slice, values);
+  return PrintValues (os, values);
 }
 
 std::string
@@ -382,6 +408,34 @@ LinkInfo::PrintHeader (std::ostream &os)
   return os;
 }
 
+std::ostream &
+LinkInfo::PrintValues (std::ostream &os, const int64_t *values)
+{
+  std::string linkDescStr;
+  linkDescStr += std::to_string (values [0]);
+  linkDescStr += "->";
+  linkDescStr += std::to_string (values [1]);
+
+  os << " " << setw (9)  << linkDescStr
+     << " " << setw (11) << Bps2Kbps (values [2])
+     << " " << setw (8)  << values [3];
+  for (int v = 4; v < N_LINK_VALUES; v++)
+    {
+      os << " " << setw (11) << Bps2Kbps (values [v]);
+    }
+  return os;
+}
+
+const std::vector<std::string> &
+LinkInfo::GetValueNames (void)
+{
+  static const std::vector<std::string> names = {
+    "DpId0", "DpId1", "LinkBps", "Quota", "QuoBps", "ExtBps", "MaxBps",
+    "ResBps", "UnrBps", "MetBps", "UseAFBps", "UseBEBps", "UsePRIOBps",
+    "OverBps", "IdleBps"};
+  return names;
+}
+
 void
 LinkInfo::DoDispose ()
 {
@@ -410,6 +464,7 @@ LinkInfo::NotifyTxPacket (std::string context, Ptr<const Packet> packet)
 {
   NS_LOG_FUNCTION (this << context << packet);
 
+  RuntimeProfiler::Scope profScope (RuntimeProfiler::LINK_TX);
   LinkInfo::LinkDir dir;
   dir = (context == "Forward") ? LinkInfo::FWD : LinkInfo::BWD;
 
@@ -516,6 +571,8 @@ LinkInfo::UpdateExtBitRate (LinkDir dir, int slice, int64_t bitRate)
   NS_LOG_DEBUG ("Slice id " << slice <<
                 " with new extra bit rate " << GetExtBitRate (dir, slice) <<
                 " in " << LinkDirStr (dir) << " direction.");
+
+  m_extraTrace (dir, slice, GetExtBitRate (dir, slice));
   return true;
 }
 
@@ -543,6 +600,7 @@ LinkInfo::SetMetBitRate (LinkDir dir, int slice, int64_t bitRate)
 void
 LinkInfo::EwmaUpdate (void)
 {
+  RuntimeProfiler::Scope profScope (RuntimeProfiler::LINK_EWMA);
   double elapSecs = (Simulator::Now () - m_ewmaLastTime).GetSeconds ();
   for (int s = 0; s <= SLICE_ALL; s++)
     {
@@ -70,6 +70,7 @@ typedef std::vector<Ptr<LinkInfo> > LinkInfoList_t;
 class LinkInfo : public Object
 {
   friend class Controller;
+  friend class MicroBenchmark;
 
 public:
   /** Link direction. */
@@ -83,17 +84,20 @@ public:
   // Total number of valid LinkDir items + 1.
   #define N_LINK_DIRS (static_cast<int> (LinkInfo::BWD) + 1)
 
+  // Number of link metadata values for each direction and slice.
+  #define N_LINK_VALUES 15
+
   /**
    * Complete constructor.
    * \param port1 First switch port.
    * \param port2 Second switch port.
-   * \param channel The CsmaChannel physical link connecting these ports.
-   * \attention The port order must be the same as created by the CsmaHelper.
+   * \param channel The csma or point-to-point channel connecting these ports.
+   * \attention The port order must be the same as created by the helper.
    * Internal channel handling is based on this order to get correct
    * full-duplex links.
    */
   LinkInfo (Ptr<OFSwitch13Port> port1, Ptr<OFSwitch13Port> port2,
-            Ptr<CsmaChannel> channel);
+            Ptr<Channel> channel);
   virtual ~LinkInfo ();   //!< Dummy destructor, see DoDispose.
 
   /**
@@ -109,7 +113,7 @@ public:
    */
   //\{
   Mac48Address          GetPortAddr   (uint8_t idx) const;
-  Ptr<CsmaNetDevice>    GetPortDev    (uint8_t idx) const;
+  Ptr<NetDevice>        GetPortDev    (uint8_t idx) const;
   uint32_t              GetPortNo     (uint8_t idx) const;
   Ptr<OFSwitch13Queue>  GetPortQueue  (uint8_t idx) const;
   Ptr<OFSwitch13Device> GetSwDev      (uint8_t idx) const;
@@ -256,13 +260,22 @@ public:
   bool HasBitRate (
     LinkDir dir, int slice, int64_t bitRate, double blockThs) const;
 
+  /**
+   * Get the link metadata for a specific link direction and network slice,
+   * with bit rates in bps.
+   * \param dir The link direction.
+   * \param slice The network slice.
+   * \param values The array of N_LINK_VALUES values to fill.
+   * \internal Keep this method consistent with the GetValueNames () method.
+   */
+  void GetValues (LinkDir dir, int slice, int64_t *values) const;
+
   /**
    * Print the link metadata for a specific link direction and network slice.
    * \param os The output stream.
    * \param dir The link direction.
    * \param slice The network slice.
    * \return The output stream.
-   * \internal Keep this method consistent with the PrintHeader () method.
    */
   std::ostream & PrintValues (
     std::ostream &os, LinkDir dir, int slice) const;
@@ -304,6 +317,29 @@ public:
    */
   static std::ostream & PrintHeader (std::ostream &os);
 
+  /**
+   * Print link metadata values previously obtained by GetValues ().
+   * \param os The output stream.
+   * \param values The array of N_LINK_VALUES values.
+   * \return The output stream.
+   * \internal Keep this method consistent with the PrintHeader () method.
+   */
+  static std::ostream & PrintValues (std::ostream &os, const int64_t *values);
+
+  /**
+   * Get the names of the values filled by GetValues ().
+   * \return The list of N_LINK_VALUES names.
+   */
+  static const std::vector<std::string> & GetValueNames (void);
+
+  /**
+   * TracedCallback signature for extra bit rate updates.
+   * \param dir The link direction.
+   * \param slice The network slice.
+   * \param bitRate The new extra bit rate.
+   */
+  typedef void (*ExtraTracedCallback)(LinkDir dir, int slice, int64_t bitRate);
+
 protected:
   /** Destructor implementation. */
   virtual void DoDispose ();
@@ -382,7 +418,12 @@ private:
     int64_t txBytes [N_TRAFFIC_TYPES_ALL]; //!< TX byte counter.
   };
 
-  Ptr<CsmaChannel>      m_channel;              //!< The CSMA link channel.
+  /** Trace source fired when the slice extra bit rate changes. */
+  TracedCallback<LinkDir, int, int64_t> m_extraTrace;
+
+  Ptr<Channel>          m_channel;              //!< The link channel.
+  DataRate              m_linkRate;             //!< The link data rate.
+  bool                  m_fullDuplex;           //!< Full-duplex link.
   Ptr<OFSwitch13Port>   m_ports [2];            //!< OpenFlow ports.
 
   /** Metadata for each network slice in each link direction. */
@@ -76,6 +76,12 @@ SliceInfo::GetTypeId (void)
                    UintegerValue (0),
                    MakeUintegerAccessor (&SliceInfo::m_numHostsB),
                    MakeUintegerChecker<uint16_t> (0, 255))
+    .AddAttribute ("LightHosts",
+                   "Install the lightweight UDP-only stack into slice hosts.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SliceInfo::m_lightHosts),
+                   MakeBooleanChecker ())
     .AddAttribute ("AppHelper", "Application helper for traffic configuration.",
                    TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
                    StringValue ("ns3::UdpPeerHelper[]"),
@@ -84,171 +90,78 @@ SliceInfo::GetTypeId (void)
   
     .AddAttribute ("AppsConfig", "Configuration for slice applications.",
                    TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
-                   StringValue ("AppsConfig"),
+                   StringValue ("()"),
                    MakeStringAccessor (&SliceInfo::m_appsConfig),
                    MakeStringChecker ())
+    .AddAttribute ("AppsConfigFile",
+                   "JSON file with the configuration for slice applications "
+                   "(overrides AppsConfig when not empty).",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   StringValue (""),
+                   MakeStringAccessor (&SliceInfo::m_appsConfigFile),
+                   MakeStringChecker ())
   ;
   return tid;
 }
 
-void 
-SliceInfo::removeBraces(std::string *str){
-    
-    size_t i = 0;
-    while(i < str->size()){
-        
-        if(str->at(i) == '{' || str->at(i) == '}')
-        {
-            str->erase(i,1);
-        } else {
-            i++;
-        }
-    }
-    
-}
+void
+SliceInfo::parseAppsConfig (std::string source, uint32_t line,
+                            uint32_t column)
+{
+  NS_LOG_FUNCTION (this << source << line << column);
 
-void 
-SliceInfo::removeParenthesis(std::string *str){
-    
-    size_t i = 0;
-    while(i < str->size()){
-        
-        if(str->at(i) == '(' || str->at(i) == ')')
-        {
-            str->erase(i,1);
-        } else {
-            i++;
-        }
+  // The JSON file, when set, replaces the compact AppsConfig string.
+  if (!m_appsConfigFile.empty ())
+    {
+      m_appConfigs = AppsConfigParser::LoadJsonFile (m_appsConfigFile);
+    }
+  else
+    {
+      AppsConfigParser parser (source, line, column);
+      m_appConfigs = parser.ParseCompact (m_appsConfig);
     }
-    
-}
-
-Ipv4Header::DscpType
-SliceInfo::stringToDscpType(std::string dscpString){
-  
-      if(dscpString == "EF"){
-
-        return Ipv4Header::DSCP_EF;
-      }  
-      else if(dscpString == "AF41"){
-         
-        return Ipv4Header::DSCP_AF41;
-      }
-      else if(dscpString == "AF31"){
-
-        return Ipv4Header::DSCP_AF31;
-      }  
-      else if(dscpString == "AF32"){
-
-        return Ipv4Header::DSCP_AF32;
-      }  
-      else if(dscpString == "AF21"){
-
-        return Ipv4Header::DSCP_AF21;
-      }
-      else if(dscpString == "AF11"){
-
-        return Ipv4Header::DSCP_AF11;
-      }
-      else{
-        return Ipv4Header::DscpDefault;
-      }
 }
 
+void
+SliceInfo::createAppHelpers ()
+{
+  NS_LOG_FUNCTION (this);
 
-
-void 
-SliceInfo::createAppHelpers(){
-
-  // Parse the string
-  // String format = ({50, 1200, 10, 250, 140, false, false, EF,}; {60, 1200, 10, 250, 140, false, false, EF,}; {70, 1200, 10, 250, 140, false, false, EF,}; {80, 1200, 10, 250, 140, false, false, EF,};)
-  std::string input= m_appsConfig;
-
-
-  size_t pos = 0;
-  std::string delimiter = ";";
-  std::string appToken;
-  while ((pos = input.find(delimiter)) != std::string::npos) {
-
+  m_appHelpers.clear ();
+  for (auto const &config : m_appConfigs)
+    {
       Ptr<UdpPeerHelper> appHelper = CreateObject<UdpPeerHelper> ();
-      
-      appToken = input.substr(0, pos);
-      input.erase(0, pos + delimiter.length());
-      removeParenthesis(&appToken);
-      removeBraces(&appToken);
-      // std::cout << appToken << std::endl;
-      
-      size_t appTokenPos = 0;
-      std::string delimiterAppToken = ",";
-      std::string appTokenProperty;
-      uint16_t appTokenPropertyNumber = 0;
-      while ((appTokenPos = appToken.find(delimiterAppToken)) != std::string::npos){
-
-          appTokenPropertyNumber++;
-          appTokenProperty = appToken.substr(0, appTokenPos);
-          appToken.erase(0, appTokenPos + delimiterAppToken.length());
-
-          uint16_t appTokenPropertyInt;
-          std::string dataRateString;
-          std::string startIntervalString;
-          std::string trafficLengthString;
-          switch(appTokenPropertyNumber){
-
-            case 1:
-              
-              appTokenPropertyInt = std::stoi(appTokenProperty);
-              std:: cout << "NumApps=" << appTokenPropertyInt << std::endl;
-              appHelper->SetAttribute ("NumApps", UintegerValue (appTokenPropertyInt));
-              break;
-            case 2:
-              // appTokenPropertyInt = std::stoi(appTokenProperty);
-              std:: cout << "DataRate=" << appTokenProperty << std::endl;
-              dataRateString = "ns3::ExponentialRandomVariable[Mean=" + appTokenProperty + "]";
-              appHelper->SetAttribute ("DataRate", StringValue(dataRateString));
-              break;
-            case 3:
-              // appTokenPropertyInt = std::stoi(appTokenProperty);
-              std:: cout << "StartInterval=" << appTokenProperty << std::endl;
-              startIntervalString = "ns3::ExponentialRandomVariable[Mean=" + appTokenProperty + "]";
-              appHelper->SetAttribute ("StartInterval", StringValue(startIntervalString));
-              break;
-            case 4:
-              appTokenPropertyInt = std::stoi(appTokenProperty);
-              std:: cout << "StartOffset=" << appTokenPropertyInt << std::endl;
-              appHelper->SetAttribute ("StartOffset", TimeValue(Seconds(appTokenPropertyInt)));
-              break;
-            case 5:
-              // appTokenPropertyInt = std::stoi(appTokenProperty);
-              std:: cout << "TrafficLength=" << appTokenProperty << std::endl;
-              trafficLengthString = "ns3::NormalRandomVariable[Mean=" + appTokenProperty + "|Variance=100]";
-              appHelper->SetAttribute ("TrafficLength", StringValue(trafficLengthString));
-              break;
-            case 6: 
-              appTokenPropertyInt = std::stoi(appTokenProperty);
-              std:: cout << "FullDuplex=" << appTokenPropertyInt << std::endl;
-              appHelper->SetAttribute ("FullDuplex", ((appTokenPropertyInt == 1) ? BooleanValue(true) : BooleanValue(false)));
-              break;
-            case 7:
-              appTokenPropertyInt = std::stoi(appTokenProperty);
-              std::cout << "SplitTraffic=" << appTokenPropertyInt << std::endl;
-              appHelper->SetAttribute ("SplitTraffic", ((appTokenPropertyInt == 1) ? BooleanValue(true) : BooleanValue(false)));
-              break;
-            case 8:
-              std::cout << "DSCP=" << appTokenProperty << std::endl;
-              appHelper->SetAttribute ("DSCP", EnumValue (stringToDscpType(appTokenProperty)));
-              break;
-            case 9:
-              appTokenPropertyInt = std::stoi(appTokenProperty);
-              std::cout << "TTYPE=" << appTokenProperty << std::endl;
-              appHelper->SetAttribute ("TQosType", EnumValue (appTokenPropertyInt));
-              break;           
-            }
-      }
-      
-      m_appHelpers.push_back(appHelper);
-
-  }
-
+      appHelper->SetAttribute (
+        "NumApps", UintegerValue (config.numApps));
+      appHelper->SetAttribute (
+        "DataRate", PointerValue (
+          CreateObjectWithAttributes<ExponentialRandomVariable> (
+            "Mean", DoubleValue (config.dataRate))));
+      appHelper->SetAttribute (
+        "StartInterval", PointerValue (
+          CreateObjectWithAttributes<ExponentialRandomVariable> (
+            "Mean", DoubleValue (config.startInterval))));
+      appHelper->SetAttribute (
+        "StartOffset", TimeValue (Seconds (config.startOffset)));
+      appHelper->SetAttribute (
+        "TrafficLength", PointerValue (
+          CreateObjectWithAttributes<NormalRandomVariable> (
+            "Mean", DoubleValue (config.trafficLength),
+            "Variance", DoubleValue (100))));
+      appHelper->SetAttribute (
+        "FullDuplex", BooleanValue (config.fullDuplex));
+      appHelper->SetAttribute (
+        "SplitTraffic", BooleanValue (config.split));
+      appHelper->SetAttribute (
+        "DSCP", EnumValue (config.dscp));
+      appHelper->SetAttribute (
+        "TQosType", EnumValue (config.tQosType));
+      appHelper->SetAttribute (
+        "Elastic", BooleanValue (config.elastic));
+      appHelper->SetAttribute (
+        "DemandProfile", StringValue (config.profile));
+      m_appHelpers.push_back (appHelper);
+    }
 }
 
 void
@@ -341,6 +254,12 @@ SliceInfo::GetNumHostsC (void) const
   return m_numHostsA + m_numHostsB;
 }
 
+bool
+SliceInfo::GetLightHosts (void) const
+{
+  return m_lightHosts;
+}
+
 Ptr<UdpPeerHelper>
 SliceInfo::GetAppHelper (void)
 {
@@ -369,6 +288,7 @@ void
 SliceInfo::DoDispose ()
 {
   m_appHelper = 0;
+  m_appHelpers.clear ();
   Object::DoDispose ();
 }
 
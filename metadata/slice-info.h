@@ -24,6 +24,7 @@
 
 #include <ns3/core-module.h>
 #include "../application/udp-peer-helper.h"
+#include "apps-config-parser.h"
 
 namespace ns3 {
 
@@ -60,10 +61,20 @@ public:
   void SetNumHostsB   (uint16_t value);
   //\}
 
-  void createAppHelpers();
-  void removeBraces(std::string *str);
-  void removeParenthesis(std::string *str);
-  Ipv4Header::DscpType stringToDscpType(std::string dscpString);
+  /**
+   * Parse and validate the applications configuration for this slice.
+   * \param source The configuration source name used in error messages.
+   * \param line The line number of the AppsConfig value in the source.
+   * \param column The column number of the AppsConfig value in the source.
+   */
+  void parseAppsConfig (std::string source = "AppsConfig",
+                        uint32_t line = 1, uint32_t column = 1);
+
+  /**
+   * Create the application helpers from the parsed configuration. The helper
+   * random variables are created here, so they use the current RngRun.
+   */
+  void createAppHelpers ();
 
   /**
    * \name Private member accessors for slice information.
@@ -77,6 +88,7 @@ public:
   uint16_t GetNumHostsA   (void) const;
   uint16_t GetNumHostsB   (void) const;
   uint16_t GetNumHostsC   (void) const;
+  bool     GetLightHosts  (void) const;
   //\}
 
   /**
@@ -144,11 +156,14 @@ private:
   uint16_t            m_quota;      //!< Slice quota.
   uint16_t            m_numHostsA;  //!< Number of hosts attached to switch A.
   uint16_t            m_numHostsB;  //!< Number of hosts attached to switch B.
+  bool                m_lightHosts; //!< Lightweight host stack.
   Ptr<UdpPeerHelper>  m_appHelper;  //!< Application helper for this slice.
 
 
   std::vector<Ptr<UdpPeerHelper>> m_appHelpers; //!< Application helpers for this slice.
   std::string m_appsConfig;//!< Configuration for slice applications.
+  std::string m_appsConfigFile; //!< JSON file with the apps configuration.
+  std::vector<AppConfig> m_appConfigs; //!< Parsed apps configuration.
 
 
   /**
@@ -22,33 +22,50 @@
 
 #include "slice-tag.h"
 
+// Packed tag format version and field limits.
+#define SLICE_TAG_VERSION   1
+#define SLICE_TAG_MAX_TIME  ((static_cast<uint64_t> (1) << 48) - 1)
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("SliceTag");
 NS_OBJECT_ENSURE_REGISTERED (SliceTag);
 
 SliceTag::SliceTag ()
-  : m_time (Simulator::Now ().GetTimeStep ()),
+  : m_time (Simulator::Now ().GetNanoSeconds ()),
   m_slice (0),
-  m_type (QosType::NON),
   m_ttype (TQosType::BE)
 {
 }
 
 SliceTag::SliceTag (uint8_t slice)
-  : m_time (Simulator::Now ().GetTimeStep ()),
+  : m_time (Simulator::Now ().GetNanoSeconds ()),
   m_slice (slice),
-  m_type (QosType::NON),
   m_ttype (TQosType::BE)
 {
+  NS_ASSERT_MSG (slice <= 0xF, "Slice ID cannot exceed 4 bits.");
+  NS_ASSERT_MSG (m_time <= SLICE_TAG_MAX_TIME, "Timestamp exceeds 48 bits.");
+}
+
+SliceTag::SliceTag (uint8_t slice, TQosType ttype)
+  : m_time (Simulator::Now ().GetNanoSeconds ()),
+  m_slice (slice),
+  m_ttype (ttype)
+{
+  NS_ASSERT_MSG (slice <= 0xF, "Slice ID cannot exceed 4 bits.");
+  NS_ASSERT_MSG (ttype < TQosType::ALL, "Invalid traffic type for tag.");
+  NS_ASSERT_MSG (m_time <= SLICE_TAG_MAX_TIME, "Timestamp exceeds 48 bits.");
 }
 
-SliceTag::SliceTag (uint8_t slice, QosType type, TQosType ttype)
-  : m_time (Simulator::Now ().GetTimeStep ()),
+SliceTag::SliceTag (uint8_t slice, TQosType ttype, Time timestamp)
+  : m_time (timestamp.GetNanoSeconds ()),
   m_slice (slice),
-  m_type (type),
   m_ttype (ttype)
 {
+  NS_ASSERT_MSG (slice <= 0xF, "Slice ID cannot exceed 4 bits.");
+  NS_ASSERT_MSG (ttype < TQosType::ALL, "Invalid traffic type for tag.");
+  NS_ASSERT_MSG (!timestamp.IsStrictlyNegative (), "Negative timestamp.");
+  NS_ASSERT_MSG (m_time <= SLICE_TAG_MAX_TIME, "Timestamp exceeds 48 bits.");
 }
 
 TypeId
@@ -70,39 +87,48 @@ SliceTag::GetInstanceTypeId (void) const
 uint32_t
 SliceTag::GetSerializedSize (void) const
 {
-  return 11;
+  return 7;
 }
 
 void
 SliceTag::Serialize (TagBuffer i) const
 {
-  i.WriteU64 (m_time);
-  i.WriteU8  (m_slice);
-  i.WriteU8  (m_type);
-  i.WriteU8  (m_ttype);
+  uint8_t header = SLICE_TAG_VERSION;
+  header <<= 2;
+  header |= (m_ttype & 0x3);
+  header <<= 4;
+  header |= (m_slice & 0xF);
+
+  i.WriteU8  (header);
+  i.WriteU16 (static_cast<uint16_t> (m_time >> 32));
+  i.WriteU32 (static_cast<uint32_t> (m_time));
 }
 
 void
 SliceTag::Deserialize (TagBuffer i)
 {
-  m_time  = i.ReadU64 ();
-  m_slice = i.ReadU8 ();
-  m_type  = i.ReadU8 ();
-  m_ttype  = i.ReadU8 ();
+  uint8_t header = i.ReadU8 ();
+  NS_ABORT_MSG_IF ((header >> 6) != SLICE_TAG_VERSION,
+                   "Unsupported slice tag version " << (header >> 6));
+  m_slice = header & 0xF;
+  m_ttype = (header >> 4) & 0x3;
+
+  m_time  = static_cast<uint64_t> (i.ReadU16 ()) << 32;
+  m_time |= i.ReadU32 ();
 }
 
 void
 SliceTag::Print (std::ostream &os) const
 {
   os << " time="  << m_time
-     << " slice=" << m_slice
-     << " type="  << QosTypeStr (GetQosType ());
+     << " slice=" << static_cast<uint16_t> (m_slice)
+     << " type="  << TQosTypeStr (GetTQosType ());
 }
 
 Time
 SliceTag::GetTimestamp () const
 {
-  return Time (m_time);
+  return NanoSeconds (m_time);
 }
 
 uint8_t
@@ -114,7 +140,7 @@ SliceTag::GetSliceId () const
 QosType
 SliceTag::GetQosType () const
 {
-  return static_cast<QosType> (m_type);
+  return Dscp2QosType (trafficTypeToDscpHeader (GetTQosType ()));
 }
 
 TQosType
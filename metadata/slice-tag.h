@@ -34,6 +34,19 @@ class Tag;
 
 /**
  * Tag used for packets in the network.
+ *
+ * \internal
+ * The QoS type is not carried by the tag, as it can be derived from the
+ * traffic type through the same DSCP mapping used by the applications. We are
+ * using the following packed serialization format:
+ * \verbatim
+ * Tag has 7 bytes length: 0x 00 000000000000
+ *                           |--|------------|
+ *                            A        B
+ *
+ *  8 (A) bits are used for the version (2), traffic type (2) and slice (4).
+ * 48 (B) bits are used for the timestamp in nanoseconds since time zero.
+ * \endverbatim
  */
 class SliceTag : public Tag
 {
@@ -44,8 +57,8 @@ public:
   /** Constructors */
   SliceTag ();
   SliceTag (uint8_t slice);
-  SliceTag (uint8_t slice, QosType type);
-  SliceTag (uint8_t slice, QosType type, TQosType ttype);
+  SliceTag (uint8_t slice, TQosType ttype);
+  SliceTag (uint8_t slice, TQosType ttype, Time timestamp);
 
   // Inherited from Tag
   virtual void Serialize (TagBuffer i) const;
@@ -61,14 +74,13 @@ public:
   Time    GetTimestamp  (void) const;
   uint8_t GetSliceId    (void) const;
   QosType GetQosType    (void) const;
-  TQosType GetTQosType    (void) const;
+  TQosType GetTQosType   (void) const;
   //\}
 
 private:
-  uint64_t  m_time;        //!< Input timestamp.
+  uint64_t  m_time;        //!< Input timestamp (ns).
   uint8_t   m_slice;       //!< SliceId.
-  uint8_t   m_type;        //!< GBR or NON-GBR.
-  uint8_t   m_ttype;        //!< Traffic type.
+  uint8_t   m_ttype;       //!< Traffic type.
 };
 
 } // namespace ns3
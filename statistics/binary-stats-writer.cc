@@ -0,0 +1,205 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Thiago Guimarães <thiago.guimaraes@ice.ufjf.br>
+ *         Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+#include <cstring>
+#include "binary-stats-writer.h"
+
+// Binary statistics file format version.
+#define BIN_STATS_MAGIC   "SLCSTATS"
+#define BIN_STATS_VERSION 1
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("BinaryStatsWriter");
+
+// Maximum number of buffers waiting for the background thread.
+const uint32_t BinaryStatsWriter::m_maxPending = 4;
+
+BinaryStatsWriter::BinaryStatsWriter (std::string filename, uint32_t bufferSize)
+  : m_file (0),
+  m_bufSize (bufferSize),
+  m_closing (false),
+  m_failed (false)
+{
+  NS_LOG_FUNCTION (this << filename << bufferSize);
+
+  NS_ABORT_MSG_IF (bufferSize < 1024, "Invalid binary stats buffer size.");
+  m_file = std::fopen (filename.c_str (), "wb");
+  NS_ABORT_MSG_IF (!m_file, "Can't open binary stats file " << filename);
+
+  // Write the file header.
+  uint32_t version = BIN_STATS_VERSION;
+  m_active.reserve (m_bufSize);
+  Append (BIN_STATS_MAGIC, 8);
+  Append (&version, sizeof (version));
+
+  // Start the background thread.
+  m_thread = std::thread (&BinaryStatsWriter::FlushLoop, this);
+}
+
+BinaryStatsWriter::~BinaryStatsWriter ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Close ();
+}
+
+void
+BinaryStatsWriter::WriteSchema (uint8_t type,
+                                const std::vector<std::string> &columns)
+{
+  NS_LOG_FUNCTION (this << static_cast<uint16_t> (type));
+
+  NS_ASSERT_MSG (type > 0, "Record type 0 is reserved for schemas.");
+  NS_ASSERT_MSG (columns.size () <= 0xFF, "Too many columns for schema.");
+
+  uint8_t header [16];
+  std::memset (header, 0, sizeof (header));
+  header [2] = type;
+  header [3] = static_cast<uint8_t> (columns.size ());
+  Append (header, sizeof (header));
+  for (auto const &name : columns)
+    {
+      Append (name.c_str (), name.size () + 1);
+    }
+}
+
+void
+BinaryStatsWriter::WriteRecord (uint8_t type, uint8_t slice, uint8_t key,
+                                Time time, const int64_t *values,
+                                uint8_t nValues)
+{
+  NS_LOG_FUNCTION (this << static_cast<uint16_t> (type));
+
+  NS_ASSERT_MSG (m_file, "Binary stats writer already closed.");
+
+  uint8_t header [16];
+  int64_t timeNs = time.GetNanoSeconds ();
+  std::memset (header, 0, sizeof (header));
+  header [0] = type;
+  header [1] = slice;
+  header [2] = key;
+  header [3] = nValues;
+  std::memcpy (header + 8, &timeNs, sizeof (timeNs));
+  Append (header, sizeof (header));
+  Append (values, sizeof (int64_t) * nValues);
+}
+
+void
+BinaryStatsWriter::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (!m_file)
+    {
+      return;
+    }
+
+  // Hand over the last buffer and wait for the background thread.
+  HandOver ();
+  {
+    std::unique_lock<std::mutex> lock (m_mutex);
+    m_closing = true;
+  }
+  m_cond.notify_all ();
+  m_thread.join ();
+
+  if (m_failed)
+    {
+      NS_LOG_ERROR ("Error when writing binary stats file.");
+    }
+  std::fclose (m_file);
+  m_file = 0;
+}
+
+void
+BinaryStatsWriter::Append (const void *data, size_t size)
+{
+  if (m_active.size () + size > m_bufSize)
+    {
+      HandOver ();
+    }
+  const char *bytes = static_cast<const char*> (data);
+  m_active.insert (m_active.end (), bytes, bytes + size);
+}
+
+void
+BinaryStatsWriter::HandOver (void)
+{
+  if (m_active.empty ())
+    {
+      return;
+    }
+
+  std::unique_lock<std::mutex> lock (m_mutex);
+
+  // Block only when the background thread is falling behind.
+  m_cond.wait (lock, [this] { return m_pending.size () < m_maxPending; });
+  m_pending.push_back (std::move (m_active));
+
+  // Reuse a buffer already written to disk whenever possible.
+  if (!m_spare.empty ())
+    {
+      m_active = std::move (m_spare.back ());
+      m_spare.pop_back ();
+    }
+  else
+    {
+      m_active = std::vector<char> ();
+      m_active.reserve (m_bufSize);
+    }
+  lock.unlock ();
+  m_cond.notify_all ();
+}
+
+void
+BinaryStatsWriter::FlushLoop (void)
+{
+  std::unique_lock<std::mutex> lock (m_mutex);
+  while (true)
+    {
+      m_cond.wait (lock, [this] { return !m_pending.empty () || m_closing; });
+      if (m_pending.empty ())
+        {
+          // Closing and nothing else to write.
+          break;
+        }
+
+      std::vector<char> buffer = std::move (m_pending.front ());
+      m_pending.pop_front ();
+      lock.unlock ();
+      m_cond.notify_all ();
+
+      size_t written = std::fwrite (buffer.data (), 1, buffer.size (), m_file);
+      if (written != buffer.size ())
+        {
+          // Logging is not thread-safe. Report it when closing the file.
+          m_failed = true;
+        }
+
+      buffer.clear ();
+      lock.lock ();
+      m_spare.push_back (std::move (buffer));
+    }
+  std::fflush (m_file);
+}
+
+} // namespace ns3
@@ -0,0 +1,126 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Thiago Guimarães <thiago.guimaraes@ice.ufjf.br>
+ *         Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+#ifndef BINARY_STATS_WRITER_H
+#define BINARY_STATS_WRITER_H
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <ns3/core-module.h>
+
+namespace ns3 {
+
+/**
+ * This class writes fixed-schema binary statistic records into a single
+ * output file. Records are appended to an in-memory buffer, and full buffers
+ * are written to disk by a background thread, so the simulation thread never
+ * blocks on file I/O unless the writer falls behind by more than the maximum
+ * number of pending buffers.
+ *
+ * \internal
+ * The file starts with the 8 bytes magic "SLCSTATS" followed by the uint32_t
+ * format version. After that, the file is a sequence of records in host byte
+ * order, each one with the following 16 bytes header:
+ * \verbatim
+ * uint8_t  type     The record type (0 for schema records).
+ * uint8_t  slice    The slice ID (0 for the aggregated slice).
+ * uint8_t  key      The record key (link direction or traffic type).
+ * uint8_t  nValues  The number of int64_t values following the header.
+ * uint32_t reserved Always zero.
+ * int64_t  time     The simulation time in nanoseconds.
+ * \endverbatim
+ * A schema record (type 0) uses the key field to identify the record type it
+ * describes, followed by the NUL-terminated column names, with no values. Any
+ * schema record precedes the first record of the type it describes.
+ */
+class BinaryStatsWriter : public SimpleRefCount<BinaryStatsWriter>
+{
+public:
+  /**
+   * Complete constructor.
+   * \param filename The output filename.
+   * \param bufferSize The size of each in-memory buffer (bytes).
+   */
+  BinaryStatsWriter (std::string filename, uint32_t bufferSize);
+  virtual ~BinaryStatsWriter ();  //!< Default destructor, see Close.
+
+  /**
+   * Register the schema for a record type.
+   * \param type The record type (must be greater than zero).
+   * \param columns The column names for values in this record type.
+   */
+  void WriteSchema (uint8_t type, const std::vector<std::string> &columns);
+
+  /**
+   * Append a new record.
+   * \param type The record type.
+   * \param slice The slice ID.
+   * \param key The record key.
+   * \param time The simulation time.
+   * \param values The record values.
+   * \param nValues The number of record values.
+   */
+  void WriteRecord (uint8_t type, uint8_t slice, uint8_t key, Time time,
+                    const int64_t *values, uint8_t nValues);
+
+  /**
+   * Flush all pending buffers, stop the background thread, and close the file.
+   */
+  void Close (void);
+
+private:
+  /**
+   * Append raw bytes to the active buffer.
+   * \param data The data to append.
+   * \param size The data size.
+   */
+  void Append (const void *data, size_t size);
+
+  /**
+   * Hand over the active buffer to the background thread.
+   */
+  void HandOver (void);
+
+  /**
+   * Background thread loop writing pending buffers to disk.
+   */
+  void FlushLoop (void);
+
+  FILE                             *m_file;       //!< Output file.
+  uint32_t                          m_bufSize;    //!< Buffer size.
+  std::vector<char>                 m_active;     //!< Active buffer.
+  std::deque<std::vector<char> >    m_pending;    //!< Buffers to write.
+  std::vector<std::vector<char> >   m_spare;      //!< Recycled buffers.
+  std::mutex                        m_mutex;      //!< Pending queue mutex.
+  std::condition_variable           m_cond;       //!< Pending queue cond.
+  std::thread                       m_thread;     //!< Background thread.
+  bool                              m_closing;    //!< Closing flag.
+  bool                              m_failed;     //!< Write error flag.
+
+  static const uint32_t             m_maxPending; //!< Max pending buffers.
+};
+
+} // namespace ns3
+#endif /* BINARY_STATS_WRITER_H */
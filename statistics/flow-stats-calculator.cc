@@ -53,6 +53,13 @@ FlowStatsCalculator::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&FlowStatsCalculator::m_continuous),
                    MakeBooleanChecker ())
+    .AddAttribute ("DirectJitter",
+                   "Keep the jitter estimation from NotifyRxJitter () when "
+                   "merging other calculators into this one.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&FlowStatsCalculator::m_directJitter),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -80,6 +87,7 @@ FlowStatsCalculator::ResetCounters (void)
   m_lastResetTime = Simulator::Now ();
   m_jitter = 0;
   m_delaySum = Time ();
+  m_delayHist.Reset ();
 
   for (int r = 0; r < N_DROP_REASONS; r++)
     {
@@ -131,6 +139,29 @@ FlowStatsCalculator::NotifyRx (uint32_t rxBytes, Time timestamp)
   Time delta = (now - m_lastRxTime) - (timestamp - m_lastTimestamp);
   m_jitter += ((Abs (delta)).GetTimeStep () - m_jitter) >> 4;
   m_delaySum += (now - timestamp);
+  m_delayHist.Record (now - timestamp);
+
+  m_lastRxTime = now;
+  m_lastTimestamp = timestamp;
+}
+
+void
+FlowStatsCalculator::NotifyRxJitter (Time timestamp)
+{
+  NS_LOG_FUNCTION (this << timestamp);
+
+  Time now = Simulator::Now ();
+
+  // Check for the first RX packet since the last reset.
+  if (m_lastRxTime == Time::Min ())
+    {
+      m_lastRxTime = now;
+      m_lastTimestamp = timestamp;
+    }
+
+  // Same jitter estimation used by NotifyRx ().
+  Time delta = (now - m_lastRxTime) - (timestamp - m_lastTimestamp);
+  m_jitter += ((Abs (delta)).GetTimeStep () - m_jitter) >> 4;
 
   m_lastRxTime = now;
   m_lastTimestamp = timestamp;
@@ -148,6 +179,54 @@ FlowStatsCalculator::NotifyDrop (uint32_t dpBytes, DropReason reason)
   m_dpBytes [DropReason::ALL] += dpBytes;
 }
 
+void
+FlowStatsCalculator::Merge (const FlowStatsCalculator &other)
+{
+  NS_LOG_FUNCTION (this << &other);
+
+  // Updating the jitter estimation before the RX counters.
+  int64_t rxPackets = GetRxPackets () + other.GetRxPackets ();
+  if (rxPackets && !m_directJitter)
+    {
+      m_jitter = (m_jitter * GetRxPackets () +
+                  other.m_jitter * other.GetRxPackets ()) / rxPackets;
+    }
+
+  // Extending the TX/RX times only when the other calculator has packets.
+  if (other.GetTxPackets ())
+    {
+      m_firstTxTime = GetTxPackets () ?
+        Min (m_firstTxTime, other.m_firstTxTime) : other.m_firstTxTime;
+      m_lastTxTime = GetTxPackets () ?
+        Max (m_lastTxTime, other.m_lastTxTime) : other.m_lastTxTime;
+    }
+  if (other.GetRxPackets ())
+    {
+      if (!GetRxPackets () || other.m_lastRxTime > m_lastRxTime)
+        {
+          m_lastTimestamp = other.m_lastTimestamp;
+        }
+      m_firstRxTime = GetRxPackets () ?
+        Min (m_firstRxTime, other.m_firstRxTime) : other.m_firstRxTime;
+      m_lastRxTime = GetRxPackets () ?
+        Max (m_lastRxTime, other.m_lastRxTime) : other.m_lastRxTime;
+    }
+
+  m_txPackets += other.m_txPackets;
+  m_txBytes += other.m_txBytes;
+  m_rxPackets += other.m_rxPackets;
+  m_rxBytes += other.m_rxBytes;
+  m_delaySum += other.m_delaySum;
+  m_delayHist.Merge (other.m_delayHist);
+  m_lastResetTime = Min (m_lastResetTime, other.m_lastResetTime);
+
+  for (int r = 0; r < N_DROP_REASONS; r++)
+    {
+      m_dpBytes [r] += other.m_dpBytes [r];
+      m_dpPackets [r] += other.m_dpPackets [r];
+    }
+}
+
 int64_t
 FlowStatsCalculator::GetDpBytes (DropReason reason) const
 {
@@ -272,6 +351,14 @@ FlowStatsCalculator::GetRxJitter (void) const
   return Time (m_jitter);
 }
 
+Time
+FlowStatsCalculator::GetRxDelayPercentile (double percentile) const
+{
+  NS_LOG_FUNCTION (this << percentile);
+
+  return m_delayHist.GetPercentile (percentile);
+}
+
 DataRate
 FlowStatsCalculator::GetRxThroughput (void) const
 {
@@ -287,6 +374,30 @@ FlowStatsCalculator::GetRxThroughput (void) const
     }
 }
 
+void
+FlowStatsCalculator::GetValues (int64_t *values) const
+{
+  NS_LOG_FUNCTION (this);
+
+  *values++ = GetActiveTime ().GetNanoSeconds ();
+  *values++ = GetTxPackets ();
+  *values++ = GetRxPackets ();
+  *values++ = GetTxBytes ();
+  *values++ = GetRxBytes ();
+  *values++ = GetRxDelay ().GetNanoSeconds ();
+  *values++ = GetRxJitter ().GetNanoSeconds ();
+  *values++ = GetRxDelayPercentile (50).GetNanoSeconds ();
+  *values++ = GetRxDelayPercentile (90).GetNanoSeconds ();
+  *values++ = GetRxDelayPercentile (99).GetNanoSeconds ();
+  *values++ = GetRxDelayPercentile (99.9).GetNanoSeconds ();
+  *values++ = static_cast<int64_t> (GetRxThroughput ().GetBitRate ());
+  *values++ = GetDpBytes (FlowStatsCalculator::ALL);
+  for (int r = FlowStatsCalculator::ALL; r >= 0; r--)
+    {
+      *values++ = GetDpPackets (static_cast<DropReason> (r));
+    }
+}
+
 std::ostream &
 FlowStatsCalculator::PrintHeader (std::ostream &os)
 {
@@ -297,6 +408,10 @@ FlowStatsCalculator::PrintHeader (std::ostream &os)
      << " " << setw (8)  << "RxBytes"
      << " " << setw (8)  << "DlyMsec"
      << " " << setw (8)  << "JitMsec"
+     << " " << setw (8)  << "P50Msec"
+     << " " << setw (8)  << "P90Msec"
+     << " " << setw (8)  << "P99Msec"
+     << " " << setw (8)  << "P999Msec"
      << " " << setw (11) << "ThpKbps"
      << " " << setw (8)  << "DpBytes"
      << " " << setw (6)  << "DpPkts"
@@ -308,6 +423,38 @@ FlowStatsCalculator::PrintHeader (std::ostream &os)
   return os;
 }
 
+std::ostream &
+FlowStatsCalculator::PrintValues (std::ostream &os, const int64_t *values)
+{
+  os << " " << setw (8)  << NanoSeconds (values [0]).GetSeconds ()
+     << " " << setw (7)  << values [1]
+     << " " << setw (7)  << values [2]
+     << " " << setw (8)  << values [3]
+     << " " << setw (8)  << values [4];
+  for (int v = 5; v < 11; v++)
+    {
+      // Delay, jitter, and delay percentiles in milliseconds.
+      os << " " << setw (8)  << NanoSeconds (values [v]).GetSeconds () * 1000;
+    }
+  os << " " << setw (11) << Bps2Kbps (values [11])
+     << " " << setw (8)  << values [12];
+  for (int v = 13; v < N_FLOW_VALUES; v++)
+    {
+      os << " " << setw (6) << values [v];
+    }
+  return os;
+}
+
+const std::vector<std::string> &
+FlowStatsCalculator::GetValueNames (void)
+{
+  static const std::vector<std::string> names = {
+    "ActvNs", "TxPkts", "RxPkts", "TxBytes", "RxBytes", "DlyNs", "JitNs",
+    "P50Ns", "P90Ns", "P99Ns", "P999Ns", "ThpBps", "DpBytes", "DpPkts",
+    "DpQue", "DpSli", "DpMbr", "DpLoa", "DpTab"};
+  return names;
+}
+
 void
 FlowStatsCalculator::DoDispose ()
 {
@@ -330,22 +477,9 @@ FlowStatsCalculator::GetLastTxRxTime (void) const
 
 std::ostream & operator << (std::ostream &os, const FlowStatsCalculator &stats)
 {
-  os << " " << setw (8)  << stats.GetActiveTime ().GetSeconds ()
-     << " " << setw (7)  << stats.GetTxPackets ()
-     << " " << setw (7)  << stats.GetRxPackets ()
-     << " " << setw (8)  << stats.GetTxBytes ()
-     << " " << setw (8)  << stats.GetRxBytes ()
-     << " " << setw (8)  << stats.GetRxDelay ().GetSeconds () * 1000
-     << " " << setw (8)  << stats.GetRxJitter ().GetSeconds () * 1000
-     << " " << setw (11) << Bps2Kbps (stats.GetRxThroughput ())
-     << " " << setw (8)  << stats.GetDpBytes (FlowStatsCalculator::ALL);
-
-  for (int r = FlowStatsCalculator::ALL; r >= 0; r--)
-    {
-      os << " " << setw (6) << stats.GetDpPackets (
-        static_cast<FlowStatsCalculator::DropReason> (r));
-    }
-  return os;
+  int64_t values [N_FLOW_VALUES];
+  stats.GetValues (values);
+  return FlowStatsCalculator::PrintValues (os, values);
 }
 
 } // Namespace ns3
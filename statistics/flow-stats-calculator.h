@@ -23,6 +23,7 @@
 
 #include <ns3/core-module.h>
 #include <ns3/network-module.h>
+#include "latency-histogram.h"
 
 namespace ns3 {
 
@@ -30,7 +31,8 @@ namespace ns3 {
  * This class monitors basic QoS statistics at link level in the OpenFlow
  * network. This class monitors some basic QoS statistics of a traffic
  * flow. It counts the number of transmitted, received and dropped bytes and
- * packets. It computes the loss ratio, the average delay, and the jitter.
+ * packets. It computes the loss ratio, the average delay, the jitter, and
+ * delay percentiles from a latency histogram.
  */
 class FlowStatsCalculator : public Object
 {
@@ -49,6 +51,9 @@ public:
   // Total number of DropReason items + 1.
   #define N_DROP_REASONS (static_cast<int> (DropReason::ALL) + 1)
 
+  // Number of QoS statistics values.
+  #define N_FLOW_VALUES 19
+
   FlowStatsCalculator ();          //!< Default constructor.
   virtual ~FlowStatsCalculator (); //!< Dummy destructor, see DoDispose.
 
@@ -83,6 +88,14 @@ public:
    */
   void NotifyRx (uint32_t rxBytes, Time timestamp = Simulator::Now ());
 
+  /**
+   * Update only the jitter estimation for a new received packet. This is
+   * meant for calculators built by Merge () with the DirectJitter attribute
+   * set, so their jitter covers the merged packets in arrival order.
+   * \param timestamp The timestamp when this packet was sent.
+   */
+  void NotifyRxJitter (Time timestamp);
+
   /**
    * Update drop counters for a new dropped packet.
    * \param dpBytes The total number of bytes in this packet.
@@ -90,6 +103,17 @@ public:
    */
   void NotifyDrop (uint32_t dpBytes, DropReason reason);
 
+  /**
+   * Merge the counters of another calculator into this one. Packet and byte
+   * counters are summed, the first/last TX/RX times and the last reset time
+   * are extended to cover both calculators, and the jitter estimation is the
+   * average of both estimations weighted by the number of RX packets. With
+   * the DirectJitter attribute set, the jitter estimation of this calculator
+   * is kept instead.
+   * \param other The calculator to merge.
+   */
+  void Merge (const FlowStatsCalculator &other);
+
   /**
    * Get the traffic active time. When the ActiveSinceReset flag is true, the
    * GetActiveTime () method will consider the entire interval since the last
@@ -118,14 +142,44 @@ public:
   DataRate  GetRxThroughput (void) const;
   //\}
 
+  /**
+   * Get the packet delay at the given percentile.
+   * \param percentile The percentile in the interval (0, 100].
+   * \return The packet delay.
+   */
+  Time GetRxDelayPercentile (double percentile) const;
+
+  /**
+   * Get all QoS statistics, with times in nanoseconds and the throughput in
+   * bps.
+   * \param values The array of N_FLOW_VALUES values to fill.
+   * \internal Keep this method consistent with the GetValueNames () method.
+   */
+  void GetValues (int64_t *values) const;
+
   /**
    * Get the header for the print operator <<.
    * \param os The output stream.
    * \return The output stream.
-   * \internal Keep this method consistent with the << operator below.
+   * \internal Keep this method consistent with the PrintValues () method.
    */
   static std::ostream & PrintHeader (std::ostream &os);
 
+  /**
+   * Print QoS statistics values previously obtained by GetValues (). This is
+   * used by the print operator <<.
+   * \param os The output stream.
+   * \param values The array of N_FLOW_VALUES values.
+   * \return The output stream.
+   */
+  static std::ostream & PrintValues (std::ostream &os, const int64_t *values);
+
+  /**
+   * Get the names of the values filled by GetValues ().
+   * \return The list of N_FLOW_VALUES names.
+   */
+  static const std::vector<std::string> & GetValueNames (void);
+
   /**
    * TracedCallback signature for FlowStatsCalculator.
    * \param stats The statistics.
@@ -147,6 +201,7 @@ private:
   //\}
 
   bool      m_continuous;                 //!< Continuous traffic monitorement.
+  bool      m_directJitter;               //!< Keep jitter when merging.
   int64_t   m_dpPackets [N_DROP_REASONS]; //!< Number of dropped packets.
   int64_t   m_dpBytes [N_DROP_REASONS];   //!< Number of dropped bytes.
   int64_t   m_txPackets;                  //!< Number of TX packets.
@@ -161,6 +216,7 @@ private:
   Time      m_lastResetTime;              //!< Last reset time.
   int64_t   m_jitter;                     //!< Jitter estimation.
   Time      m_delaySum;                   //!< Sum of packet delays.
+  LatencyHistogram m_delayHist;           //!< Packet delay histogram.
 };
 
 /**
@@ -168,8 +224,6 @@ private:
  * \param os The output stream.
  * \param stats The FlowStatsCalculator object.
  * \returns The output stream.
- * \internal Keep this method consistent with the
- *           FlowStatsCalculator::PrintHeader ().
  */
 std::ostream & operator << (std::ostream &os, const FlowStatsCalculator &stats);
 
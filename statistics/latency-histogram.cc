@@ -0,0 +1,145 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Thiago Guimarães <thiago.guimaraes@ice.ufjf.br>
+ *         Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+#include <cmath>
+#include <cstring>
+#include "latency-histogram.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LatencyHistogram");
+
+LatencyHistogram::LatencyHistogram ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Reset ();
+}
+
+void
+LatencyHistogram::Reset (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  std::memset (m_counts, 0, sizeof (m_counts));
+  m_count = 0;
+  m_maxValue = 0;
+}
+
+void
+LatencyHistogram::Record (Time delay)
+{
+  NS_LOG_FUNCTION (this << delay);
+
+  uint64_t value = delay.IsStrictlyNegative () ? 0 : delay.GetNanoSeconds ();
+  m_counts [GetBucket (value)]++;
+  m_count++;
+  m_maxValue = std::max (m_maxValue, value);
+}
+
+void
+LatencyHistogram::Merge (const LatencyHistogram &other)
+{
+  NS_LOG_FUNCTION (this << &other);
+
+  if (other.m_count == 0)
+    {
+      return;
+    }
+
+  for (uint32_t b = 0; b < HIST_N_BUCKETS; b++)
+    {
+      m_counts [b] += other.m_counts [b];
+    }
+  m_count += other.m_count;
+  m_maxValue = std::max (m_maxValue, other.m_maxValue);
+}
+
+int64_t
+LatencyHistogram::GetCount (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_count;
+}
+
+Time
+LatencyHistogram::GetPercentile (double percentile) const
+{
+  NS_LOG_FUNCTION (this << percentile);
+
+  NS_ASSERT_MSG (percentile > 0 && percentile <= 100, "Invalid percentile.");
+
+  if (m_count == 0)
+    {
+      return Time (0);
+    }
+
+  uint64_t target = static_cast<uint64_t> (
+      std::ceil (percentile / 100 * m_count));
+  uint64_t seen = 0;
+  for (uint32_t b = 0; b < HIST_N_BUCKETS; b++)
+    {
+      seen += m_counts [b];
+      if (seen >= target)
+        {
+          return NanoSeconds (std::min (GetHighestValue (b), m_maxValue));
+        }
+    }
+  return NanoSeconds (m_maxValue);
+}
+
+uint32_t
+LatencyHistogram::GetBucket (uint64_t value)
+{
+  if (value < (1 << HIST_SUB_BITS))
+    {
+      return static_cast<uint32_t> (value);
+    }
+
+  // Saturate values larger than the histogram range.
+  int msb = 63 - __builtin_clzll (value);
+  if (msb >= HIST_MAX_BITS)
+    {
+      return HIST_N_BUCKETS - 1;
+    }
+
+  // The shift keeps HIST_SUB_BITS significant bits, so the mantissa lies in
+  // [2^(HIST_SUB_BITS-1), 2^HIST_SUB_BITS).
+  int shift = msb - HIST_SUB_BITS + 1;
+  uint64_t mantissa = value >> shift;
+  return (shift << (HIST_SUB_BITS - 1)) + static_cast<uint32_t> (mantissa);
+}
+
+uint64_t
+LatencyHistogram::GetHighestValue (uint32_t bucket)
+{
+  if (bucket < (1 << HIST_SUB_BITS))
+    {
+      return bucket;
+    }
+
+  int shift = (bucket >> (HIST_SUB_BITS - 1)) - 1;
+  uint64_t mantissa = bucket - (shift << (HIST_SUB_BITS - 1));
+  return ((mantissa + 1) << shift) - 1;
+}
+
+} // namespace ns3
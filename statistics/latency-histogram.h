@@ -0,0 +1,107 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Thiago Guimarães <thiago.guimaraes@ice.ufjf.br>
+ *         Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <ns3/core-module.h>
+
+// Number of sub-bucket bits, setting the histogram precision to 1/128.
+#define HIST_SUB_BITS 7
+
+// Number of bits for the largest value in the histogram (~18 minutes in ns).
+#define HIST_MAX_BITS 40
+
+// Number of histogram buckets.
+#define HIST_N_BUCKETS \
+  ((HIST_MAX_BITS - HIST_SUB_BITS) * (1 << (HIST_SUB_BITS - 1)) + \
+   (1 << HIST_SUB_BITS))
+
+namespace ns3 {
+
+/**
+ * This class implements a log-linear histogram of packet delays, in the
+ * spirit of the HDR histogram. Values below 2^HIST_SUB_BITS nanoseconds are
+ * recorded exactly. Larger values are recorded into 2^(HIST_SUB_BITS-1)
+ * linear sub-buckets per power of two, bounding the relative error of
+ * reported percentiles to 2^(1-HIST_SUB_BITS). Values larger than
+ * 2^HIST_MAX_BITS nanoseconds are saturated into the last bucket. The
+ * histogram uses fixed memory and records values in constant time.
+ */
+class LatencyHistogram
+{
+public:
+  LatencyHistogram ();  //!< Default constructor.
+
+  /**
+   * Reset all bucket counters.
+   */
+  void Reset (void);
+
+  /**
+   * Record a new delay value.
+   * \param delay The delay value.
+   */
+  void Record (Time delay);
+
+  /**
+   * Merge the counters of another histogram into this one.
+   * \param other The histogram to merge.
+   */
+  void Merge (const LatencyHistogram &other);
+
+  /**
+   * Get the number of recorded values.
+   * \return The number of values.
+   */
+  int64_t GetCount (void) const;
+
+  /**
+   * Get the delay value at the given percentile. This is the highest value
+   * equivalent to the bucket holding the percentile, limited to the
+   * maximum recorded value.
+   * \param percentile The percentile in the interval (0, 100].
+   * \return The delay value, or zero when the histogram is empty.
+   */
+  Time GetPercentile (double percentile) const;
+
+private:
+  /**
+   * Get the bucket index for a delay value.
+   * \param value The delay value in nanoseconds.
+   * \return The bucket index.
+   */
+  static uint32_t GetBucket (uint64_t value);
+
+  /**
+   * Get the highest delay value recorded into a bucket.
+   * \param bucket The bucket index.
+   * \return The delay value in nanoseconds.
+   */
+  static uint64_t GetHighestValue (uint32_t bucket);
+
+  uint64_t  m_counts [HIST_N_BUCKETS];  //!< Bucket counters.
+  int64_t   m_count;                    //!< Number of values.
+  uint64_t  m_maxValue;                 //!< Maximum value.
+};
+
+} // namespace ns3
+#endif /* LATENCY_HISTOGRAM_H */
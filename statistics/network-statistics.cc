@@ -18,19 +18,30 @@
  * Author: Luciano Chaves <luciano@lrc.ic.unicamp.br>
  */
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include "network-statistics.h"
 #include "../metadata/slice-info.h"
+#include "runtime-profiler.h"
 
 using namespace std;
 
+// Record types for the binary statistics file.
+#define BIN_REC_BWD     1
+#define BIN_REC_TFF     2
+#define BIN_REC_BWD_AGG 3
+#define BIN_REC_TFF_AGG 4
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("NetworkStatistics");
 NS_OBJECT_ENSURE_REGISTERED (NetworkStatistics);
 
 NetworkStatistics::NetworkStatistics ()
+  : m_aggCounter (0),
+  m_detailUntil (Time (0)),
+  m_detailNext (0)
 {
   NS_LOG_FUNCTION (this);
 
@@ -47,25 +58,26 @@ NetworkStatistics::NetworkStatistics ()
   //     m_slices [s].tffWrapper = 0;
   //   }
 
-  // Connect this stats calculator to required trace sources.
-  Config::Connect (
-    "/NodeList/*/ApplicationList/*/$ns3::UdpPeerApp/TxPkt",
-    MakeCallback (&NetworkStatistics::TxPacket, this));
-  Config::Connect (
-    "/NodeList/*/ApplicationList/*/$ns3::UdpPeerApp/RxPkt",
-    MakeCallback (&NetworkStatistics::RxPacket, this));
-  Config::Connect (
-    "/NodeList/*/$ns3::OFSwitch13Device/OverloadDrop",
-    MakeCallback (&NetworkStatistics::OverloadDropPacket, this));
-  Config::Connect (
-    "/NodeList/*/$ns3::OFSwitch13Device/MeterDrop",
-    MakeCallback (&NetworkStatistics::MeterDropPacket, this));
-  Config::Connect (
-    "/NodeList/*/$ns3::OFSwitch13Device/TableDrop",
-    MakeCallback (&NetworkStatistics::TableDropPacket, this));
-  Config::Connect (
-    "/NodeList/*/$ns3::OFSwitch13Device/PortList/*/PortQueue/Drop",
-    MakeCallback (&NetworkStatistics::QueueDropPacket, this));
+  // Connect this stats calculator to trace sources already installed.
+  for (NodeList::Iterator it = NodeList::Begin (); it != NodeList::End (); ++it)
+    {
+      Ptr<Node> node = *it;
+      for (uint32_t i = 0; i < node->GetNApplications (); i++)
+        {
+          Ptr<Application> app = node->GetApplication (i);
+          if (DynamicCast<UdpPeerApp> (app) || DynamicCast<UdpAggregateApp> (app))
+            {
+              RegisterApp (app);
+            }
+        }
+
+      // Switches simulated by other ranks never fire their trace sources.
+      Ptr<OFSwitch13Device> device = node->GetObject<OFSwitch13Device> ();
+      if (device && node->GetSystemId () == Simulator::GetSystemId ())
+        {
+          RegisterSwitch (device);
+        }
+    }
 }
 
 NetworkStatistics::~NetworkStatistics ()
@@ -87,10 +99,75 @@ NetworkStatistics::GetTypeId (void)
                    StringValue ("traffic"),
                    MakeStringAccessor (&NetworkStatistics::m_tffFilename),
                    MakeStringChecker ())
+    .AddAttribute ("BinStatsFilename", "Filename for binary statistics.",
+                   StringValue ("statistics"),
+                   MakeStringAccessor (&NetworkStatistics::m_binFilename),
+                   MakeStringChecker ())
+    .AddAttribute ("BinBufferSize", "Buffer size for binary statistics [bytes].",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (1 << 20),
+                   MakeUintegerAccessor (&NetworkStatistics::m_binBufSize),
+                   MakeUintegerChecker<uint32_t> (1024))
+    .AddAttribute ("OutputFormat", "Output format for statistics.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   EnumValue (NetworkStatistics::TEXT),
+                   MakeEnumAccessor (&NetworkStatistics::m_format),
+                   MakeEnumChecker (NetworkStatistics::TEXT,   "text",
+                                    NetworkStatistics::BINARY, "binary",
+                                    NetworkStatistics::BOTH,   "both"))
+    .AddAttribute ("DumpTimeout", "The interval between statistics samples.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   TimeValue (Seconds (1)),
+                   MakeTimeAccessor (&NetworkStatistics::m_dumpTimeout),
+                   MakeTimeChecker (NanoSeconds (1)))
+    .AddAttribute ("DetailHistory",
+                   "Number of recent samples kept in memory and only written "
+                   "around extra bit rate changes (0 to write all samples).",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&NetworkStatistics::m_detailHistory),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("AggregateIntervals",
+                   "Number of sample intervals merged into each aggregated "
+                   "sample (0 to disable aggregated statistics).",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&NetworkStatistics::m_aggIntervals),
+                   MakeUintegerChecker<uint32_t> ())
   ;
   return tid;
 }
 
+void
+NetworkStatistics::RegisterApp (Ptr<Application> app)
+{
+  NS_LOG_FUNCTION (this << app);
+
+  app->TraceConnectWithoutContext (
+    "TxPkt", MakeCallback (&NetworkStatistics::TxPacket, this));
+  app->TraceConnectWithoutContext (
+    "RxPkt", MakeCallback (&NetworkStatistics::RxPacket, this));
+}
+
+void
+NetworkStatistics::RegisterSwitch (Ptr<OFSwitch13Device> device)
+{
+  NS_LOG_FUNCTION (this << device);
+
+  device->TraceConnectWithoutContext (
+    "OverloadDrop", MakeCallback (&NetworkStatistics::OverloadDropPacket, this));
+  device->TraceConnectWithoutContext (
+    "MeterDrop", MakeCallback (&NetworkStatistics::MeterDropPacket, this));
+  device->TraceConnectWithoutContext (
+    "TableDrop", MakeCallback (&NetworkStatistics::TableDropPacket, this));
+  for (uint32_t p = 1; p <= device->GetSwitchPortsSize (); p++)
+    {
+      Ptr<OFSwitch13Queue> queue = device->GetSwitchPort (p)->GetPortQueue ();
+      queue->TraceConnectWithoutContext (
+        "Drop", MakeCallback (&NetworkStatistics::QueueDropPacket, this));
+    }
+}
+
 void
 NetworkStatistics::DoDispose ()
 {
@@ -101,9 +178,19 @@ NetworkStatistics::DoDispose ()
       for (int t = 0; t < N_TRAFFIC_TYPES; t++)
         {
           m_slices [s].flowStats [t] = 0;
+          m_slices [s].aggStats [t] = 0;
         }
       m_slices [s].bwdWrapper = 0;
       m_slices [s].tffWrapper = 0;
+      m_slices [s].bwdAggWrapper = 0;
+      m_slices [s].tffAggWrapper = 0;
+    }
+  m_detail.clear ();
+
+  if (m_binWriter)
+    {
+      m_binWriter->Close ();
+      m_binWriter = 0;
     }
 
   Object::DoDispose ();
@@ -119,98 +206,369 @@ NetworkStatistics::NotifyConstructionCompleted (void)
   std::string prefix = stringValue.Get ();
   SetAttribute ("BwdStatsFilename", StringValue (prefix + m_bwdFilename));
   SetAttribute ("TffStatsFilename", StringValue (prefix + m_tffFilename));
+  SetAttribute ("BinStatsFilename", StringValue (prefix + m_binFilename));
+
+  // Create the single binary output file and register the record schemas.
+  if (m_format != NetworkStatistics::TEXT)
+    {
+      const std::vector<std::string> &bwdColumns = LinkInfo::GetValueNames ();
+      const std::vector<std::string> &tffColumns =
+        FlowStatsCalculator::GetValueNames ();
+
+      m_binWriter = Create<BinaryStatsWriter> (
+          m_binFilename + ".bin", m_binBufSize);
+      m_binWriter->WriteSchema (BIN_REC_BWD, bwdColumns);
+      m_binWriter->WriteSchema (BIN_REC_TFF, tffColumns);
+      if (m_aggIntervals)
+        {
+          m_binWriter->WriteSchema (BIN_REC_BWD_AGG, bwdColumns);
+          m_binWriter->WriteSchema (BIN_REC_TFF_AGG, tffColumns);
+        }
+    }
 
   for (int s = 0; s <= static_cast<int> (SliceInfo::GetNSlices ()); s++)
     {
-      std::string sliceStr = std::to_string (s);
       SliceMetadata &slData = m_slices [s];
       for (int t = 0; t < N_TRAFFIC_TYPES; t++)
         {
+          // Slice 0 jitter is estimated over packets from all slices.
           slData.flowStats [t] =
             CreateObjectWithAttributes<FlowStatsCalculator> (
-              "Continuous", BooleanValue (true));
+              "Continuous", BooleanValue (true),
+              "DirectJitter", BooleanValue (s == 0));
+          if (m_aggIntervals)
+            {
+              slData.aggStats [t] =
+                CreateObjectWithAttributes<FlowStatsCalculator> (
+                  "Continuous", BooleanValue (true));
+            }
+        }
+
+      if (m_format == NetworkStatistics::BINARY)
+        {
+          continue;
         }
 
       // Create the output files for this slice.
+      std::string sliceStr = std::to_string (s);
       slData.bwdWrapper = Create<OutputStreamWrapper> (
           m_bwdFilename + "-" + sliceStr + ".log", std::ios::out);
       slData.tffWrapper = Create<OutputStreamWrapper> (
           m_tffFilename + "-" + sliceStr + ".log", std::ios::out);
+      if (m_aggIntervals)
+        {
+          slData.bwdAggWrapper = Create<OutputStreamWrapper> (
+              m_bwdFilename + "-agg-" + sliceStr + ".log", std::ios::out);
+          slData.tffAggWrapper = Create<OutputStreamWrapper> (
+              m_tffFilename + "-agg-" + sliceStr + ".log", std::ios::out);
+        }
 
       // Print the headers in output files.
-      *slData.bwdWrapper->GetStream ()
-        << boolalpha << right << fixed << setprecision (3)
-        << " " << setw (8) << "TimeSec"
-        << " " << setw (7) << "LinkDir";
-      LinkInfo::PrintHeader (*slData.bwdWrapper->GetStream ());
-      *slData.bwdWrapper->GetStream () << std::endl;
-
-      *slData.tffWrapper->GetStream ()
-        << boolalpha << right << fixed << setprecision (3)
-        << " " << setw (8) << "TimeSec"
-        << " " << setw (8) << "QosType";
-      FlowStatsCalculator::PrintHeader (*slData.tffWrapper->GetStream ());
-      *slData.tffWrapper->GetStream () << std::endl;
+      for (auto const &wrapper : {slData.bwdWrapper, slData.bwdAggWrapper})
+        {
+          if (wrapper)
+            {
+              *wrapper->GetStream ()
+                << boolalpha << right << fixed << setprecision (3)
+                << " " << setw (8) << "TimeSec"
+                << " " << setw (7) << "LinkDir";
+              LinkInfo::PrintHeader (*wrapper->GetStream ());
+              *wrapper->GetStream () << std::endl;
+            }
+        }
+      for (auto const &wrapper : {slData.tffWrapper, slData.tffAggWrapper})
+        {
+          if (wrapper)
+            {
+              *wrapper->GetStream ()
+                << boolalpha << right << fixed << setprecision (3)
+                << " " << setw (8) << "TimeSec"
+                << " " << setw (8) << "QosType";
+              FlowStatsCalculator::PrintHeader (*wrapper->GetStream ());
+              *wrapper->GetStream () << std::endl;
+            }
+        }
+    }
+
+  // Allocate the detail history ring buffer. Without history, a single
+  // sample is used and written at the end of each dump interval.
+  m_detail.resize (std::max (m_detailHistory, static_cast<uint32_t> (1)));
+  for (auto &sample : m_detail)
+    {
+      sample.written = true;
+    }
+
+  // Monitor extra bit rate changes to write the detail history around them.
+  if (m_detailHistory)
+    {
+      for (auto const &link : LinkInfo::GetList ())
+        {
+          link->TraceConnectWithoutContext (
+            "ExtBitRate", MakeCallback (
+              &NetworkStatistics::ExtraBitRateChanged, this));
+        }
     }
 
   // Schedule the first dump.
-  Simulator::Schedule (Seconds (1), &NetworkStatistics::DumpStatistics, this);
+  Simulator::Schedule (m_dumpTimeout, &NetworkStatistics::DumpStatistics, this);
 
   Object::NotifyConstructionCompleted ();
 }
+
 void
 NetworkStatistics::DumpStatistics (void)
 {
   NS_LOG_FUNCTION (this);
 
-  // Dump statistics for each network slice.
+  RuntimeProfiler::Scope profScope (RuntimeProfiler::STATS_DUMP);
+
+  // Build the aggregated slice 0 by merging all other slices. Slice 0 was
+  // reset at the last dump and only holds its own jitter estimation.
+  for (int t = 0; t < N_TRAFFIC_TYPES; t++)
+    {
+      for (int s = 1; s <= static_cast<int> (SliceInfo::GetNSlices ()); s++)
+        {
+          m_slices [0].flowStats [t]->Merge (*m_slices [s].flowStats [t]);
+        }
+    }
+
+  // Sample current statistics into the next detail history entry.
+  StatsSample &sample = m_detail [m_detailNext];
+  m_detailNext = (m_detailNext + 1) % m_detail.size ();
+  FillSample (sample, false);
+  if (m_detailHistory == 0 || Simulator::Now () <= m_detailUntil)
+    {
+      WriteSample (sample, false);
+    }
+
+  // Accumulate bandwidth values for the aggregated window average.
+  if (m_aggIntervals)
+    {
+      m_aggBwdSum.resize (sample.bwdValues.size (), 0);
+      for (size_t i = 0; i < sample.bwdValues.size (); i++)
+        {
+          m_aggBwdSum [i] += sample.bwdValues [i];
+        }
+    }
+
+  // Merge and reset counters for each network slice.
   for (int s = 0; s <= static_cast<int> (SliceInfo::GetNSlices ()); s++)
     {
-      SliceMetadata &slData = m_slices [s];
+      for (int t = 0; t < N_TRAFFIC_TYPES; t++)
+        {
+          if (m_aggIntervals)
+            {
+              m_slices [s].aggStats [t]->Merge (*m_slices [s].flowStats [t]);
+            }
+          m_slices [s].flowStats [t]->ResetCounters ();
+        }
+    }
 
-      // Trick to print slice ALL with index 0
+  // Dump aggregated statistics at the end of each aggregate interval.
+  if (m_aggIntervals && ++m_aggCounter == m_aggIntervals)
+    {
+      m_aggCounter = 0;
+      FillSample (m_aggSample, true);
+      WriteSample (m_aggSample, true);
+      std::fill (m_aggBwdSum.begin (), m_aggBwdSum.end (), 0);
+      for (int s = 0; s <= static_cast<int> (SliceInfo::GetNSlices ()); s++)
+        {
+          for (int t = 0; t < N_TRAFFIC_TYPES; t++)
+            {
+              m_slices [s].aggStats [t]->ResetCounters ();
+            }
+        }
+    }
+
+  // Schedule the next dump.
+  Simulator::Schedule (m_dumpTimeout, &NetworkStatistics::DumpStatistics, this);
+}
+
+void
+NetworkStatistics::FillSample (StatsSample &sample, bool aggregate)
+{
+  NS_LOG_FUNCTION (this << aggregate);
+
+  size_t nSlices = SliceInfo::GetNSlices () + 1;
+  size_t nLinks = LinkInfo::GetList ().size ();
+  sample.bwdValues.resize (nSlices * nLinks * N_LINK_DIRS * N_LINK_VALUES);
+  sample.tffValues.resize (nSlices * N_TRAFFIC_TYPES * N_FLOW_VALUES);
+  sample.time = Simulator::Now ();
+  sample.written = false;
+
+  int64_t *bwd = sample.bwdValues.data ();
+  int64_t *tff = sample.tffValues.data ();
+  for (size_t s = 0; s < nSlices; s++)
+    {
+      // Trick to get slice ALL with index 0
       int sliceId = (s == 0 ? SLICE_ALL : s);
 
+      // Slice bandwidth usage for each link. Aggregated samples get the
+      // average over the aggregate window below.
+      if (!aggregate)
+        {
+          for (auto const &link : LinkInfo::GetList ())
+            {
+              for (int d = 0; d < N_LINK_DIRS; d++)
+                {
+                  LinkInfo::LinkDir dir = static_cast<LinkInfo::LinkDir> (d);
+                  link->GetValues (dir, sliceId, bwd);
+                  bwd += N_LINK_VALUES;
+                }
+            }
+        }
+
+      // Slice traffic stats for each traffic type.
+      for (int t = 0; t < N_TRAFFIC_TYPES; t++)
+        {
+          Ptr<FlowStatsCalculator> flowStats = aggregate ?
+            m_slices [s].aggStats [t] : m_slices [s].flowStats [t];
+          flowStats->GetValues (tff);
+          tff += N_FLOW_VALUES;
+        }
+    }
+
+  if (aggregate)
+    {
+      NS_ASSERT_MSG (m_aggBwdSum.size () == sample.bwdValues.size (),
+                     "Inconsistent aggregated bandwidth values.");
+      for (size_t i = 0; i < sample.bwdValues.size (); i++)
+        {
+          sample.bwdValues [i] = m_aggBwdSum [i] / m_aggIntervals;
+        }
+    }
+}
+
+void
+NetworkStatistics::WriteSample (StatsSample &sample, bool aggregate)
+{
+  NS_LOG_FUNCTION (this << aggregate);
+
+  if (m_format != NetworkStatistics::BINARY)
+    {
+      WriteTextSample (sample, aggregate);
+    }
+  if (m_format != NetworkStatistics::TEXT)
+    {
+      WriteBinarySample (sample, aggregate);
+    }
+  sample.written = true;
+}
+
+void
+NetworkStatistics::WriteTextSample (const StatsSample &sample, bool aggregate)
+{
+  NS_LOG_FUNCTION (this << aggregate);
+
+  size_t nSlices = sample.tffValues.size () / (N_TRAFFIC_TYPES * N_FLOW_VALUES);
+  size_t nLinks = sample.bwdValues.size () /
+    (nSlices * N_LINK_DIRS * N_LINK_VALUES);
+  double timeSecs = sample.time.GetSeconds ();
+
+  const int64_t *bwd = sample.bwdValues.data ();
+  const int64_t *tff = sample.tffValues.data ();
+  for (size_t s = 0; s < nSlices; s++)
+    {
+      SliceMetadata &slData = m_slices [s];
+      std::ostream &bwdOs = *(aggregate ? slData.bwdAggWrapper :
+                              slData.bwdWrapper)->GetStream ();
+      std::ostream &tffOs = *(aggregate ? slData.tffAggWrapper :
+                              slData.tffWrapper)->GetStream ();
+
       // Dump slice bandwidth usage for each link.
-      for (auto const &link : LinkInfo::GetList ())
+      for (size_t l = 0; l < nLinks; l++)
         {
           for (int d = 0; d < N_LINK_DIRS; d++)
             {
               LinkInfo::LinkDir dir = static_cast<LinkInfo::LinkDir> (d);
-
-              *slData.bwdWrapper->GetStream ()
-                << " " << setw (8) << Simulator::Now ().GetSeconds ()
-                << " " << setw (7) << LinkInfo::LinkDirStr (dir);
-              link->PrintValues (*slData.bwdWrapper->GetStream (), dir, sliceId);
-              *slData.bwdWrapper->GetStream () << std::endl;
+              bwdOs << " " << setw (8)  << timeSecs
+                    << " " << setw (7)  << LinkInfo::LinkDirStr (dir);
+              LinkInfo::PrintValues (bwdOs, bwd);
+              bwdOs << std::endl;
+              bwd += N_LINK_VALUES;
             }
         }
-      *slData.bwdWrapper->GetStream () << std::endl;
+      bwdOs << std::endl;
 
-      // Dump slice traffic stats for each direction.
+      // Dump slice traffic stats for each traffic type.
       for (int t = 0; t < N_TRAFFIC_TYPES; t++)
         {
           TQosType type = static_cast<TQosType> (t);
-          Ptr<FlowStatsCalculator> flowStats = slData.flowStats [t];
-
-          *slData.tffWrapper->GetStream ()
-            << " " << setw (8) << Simulator::Now ().GetSeconds ()
-            << " " << setw (8) << TQosTypeStr (type)
-            << *flowStats
-            << std::endl;
-          flowStats->ResetCounters ();
+          tffOs << " " << setw (8)  << timeSecs
+                << " " << setw (8)  << TQosTypeStr (type);
+          FlowStatsCalculator::PrintValues (tffOs, tff);
+          tffOs << std::endl;
+          tff += N_FLOW_VALUES;
         }
-      *slData.tffWrapper->GetStream () << std::endl;
+      tffOs << std::endl;
     }
+}
 
-  // Schedule the next dump.
-  Simulator::Schedule (Seconds (1), &NetworkStatistics::DumpStatistics, this);
+void
+NetworkStatistics::WriteBinarySample (const StatsSample &sample, bool aggregate)
+{
+  NS_LOG_FUNCTION (this << aggregate);
+
+  size_t nSlices = sample.tffValues.size () / (N_TRAFFIC_TYPES * N_FLOW_VALUES);
+  size_t nLinks = sample.bwdValues.size () /
+    (nSlices * N_LINK_DIRS * N_LINK_VALUES);
+  uint8_t bwdType = aggregate ? BIN_REC_BWD_AGG : BIN_REC_BWD;
+  uint8_t tffType = aggregate ? BIN_REC_TFF_AGG : BIN_REC_TFF;
+
+  const int64_t *bwd = sample.bwdValues.data ();
+  const int64_t *tff = sample.tffValues.data ();
+  for (size_t s = 0; s < nSlices; s++)
+    {
+      for (size_t l = 0; l < nLinks; l++)
+        {
+          for (int d = 0; d < N_LINK_DIRS; d++)
+            {
+              m_binWriter->WriteRecord (bwdType, s, d, sample.time,
+                                        bwd, N_LINK_VALUES);
+              bwd += N_LINK_VALUES;
+            }
+        }
+      for (int t = 0; t < N_TRAFFIC_TYPES; t++)
+        {
+          m_binWriter->WriteRecord (tffType, s, t, sample.time,
+                                    tff, N_FLOW_VALUES);
+          tff += N_FLOW_VALUES;
+        }
+    }
+}
+
+void
+NetworkStatistics::FlushDetail (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // Write pending samples from the oldest to the newest one.
+  for (size_t i = 0; i < m_detail.size (); i++)
+    {
+      StatsSample &sample = m_detail [(m_detailNext + i) % m_detail.size ()];
+      if (!sample.written)
+        {
+          WriteSample (sample, false);
+        }
+    }
+  m_detailUntil = Simulator::Now () + m_dumpTimeout * m_detailHistory;
+}
+
+void
+NetworkStatistics::ExtraBitRateChanged (
+  LinkInfo::LinkDir dir, int slice, int64_t bitRate)
+{
+  NS_LOG_FUNCTION (this << dir << slice << bitRate);
+
+  FlushDetail ();
 }
 
 void
-NetworkStatistics::OverloadDropPacket (std::string context, Ptr<const Packet> packet)
+NetworkStatistics::OverloadDropPacket (Ptr<const Packet> packet)
 {
-  NS_LOG_FUNCTION (this << context << packet);
+  NS_LOG_FUNCTION (this << packet);
+
+  RuntimeProfiler::Scope profScope (RuntimeProfiler::STATS_SINK);
 
   SliceTag sliceTag;
   if (packet->PeekPacketTag (sliceTag))
@@ -220,17 +578,15 @@ NetworkStatistics::OverloadDropPacket (std::string context, Ptr<const Packet> pa
 
       Ptr<FlowStatsCalculator> slcStats = m_slices [sliceId].flowStats [qosType];
       slcStats->NotifyDrop (packet->GetSize (), FlowStatsCalculator::PLOAD);
-
-      Ptr<FlowStatsCalculator> aggStats = m_slices [0].flowStats [qosType];
-      aggStats->NotifyDrop (packet->GetSize (), FlowStatsCalculator::PLOAD);
     }
 }
 
 void
-NetworkStatistics::MeterDropPacket (
-  std::string context, Ptr<const Packet> packet, uint32_t meterId)
+NetworkStatistics::MeterDropPacket (Ptr<const Packet> packet, uint32_t meterId)
 {
-  NS_LOG_FUNCTION (this << context << packet << meterId);
+  NS_LOG_FUNCTION (this << packet << meterId);
+
+  RuntimeProfiler::Scope profScope (RuntimeProfiler::STATS_SINK);
 
   SliceTag sliceTag;
   if (packet->PeekPacketTag (sliceTag))
@@ -240,16 +596,15 @@ NetworkStatistics::MeterDropPacket (
 
       Ptr<FlowStatsCalculator> slcStats = m_slices [sliceId].flowStats [qosType];
       slcStats->NotifyDrop (packet->GetSize (), FlowStatsCalculator::SLICE);
-
-      Ptr<FlowStatsCalculator> aggStats = m_slices [0].flowStats [qosType];
-      aggStats->NotifyDrop (packet->GetSize (), FlowStatsCalculator::SLICE);
     }
 }
 
 void
-NetworkStatistics::QueueDropPacket (std::string context, Ptr<const Packet> packet)
+NetworkStatistics::QueueDropPacket (Ptr<const Packet> packet)
 {
-  NS_LOG_FUNCTION (this << context << packet);
+  NS_LOG_FUNCTION (this << packet);
+
+  RuntimeProfiler::Scope profScope (RuntimeProfiler::STATS_SINK);
 
   SliceTag sliceTag;
   if (packet->PeekPacketTag (sliceTag))
@@ -259,17 +614,15 @@ NetworkStatistics::QueueDropPacket (std::string context, Ptr<const Packet> packe
 
       Ptr<FlowStatsCalculator> slcStats = m_slices [sliceId].flowStats [qosType];
       slcStats->NotifyDrop (packet->GetSize (), FlowStatsCalculator::QUEUE);
-
-      Ptr<FlowStatsCalculator> aggStats = m_slices [0].flowStats [qosType];
-      aggStats->NotifyDrop (packet->GetSize (), FlowStatsCalculator::QUEUE);
     }
 }
 
 void
-NetworkStatistics::TableDropPacket (
-  std::string context, Ptr<const Packet> packet, uint8_t tableId)
+NetworkStatistics::TableDropPacket (Ptr<const Packet> packet, uint8_t tableId)
 {
-  NS_LOG_FUNCTION (this << context << packet << static_cast<uint16_t> (tableId));
+  NS_LOG_FUNCTION (this << packet << static_cast<uint16_t> (tableId));
+
+  RuntimeProfiler::Scope profScope (RuntimeProfiler::STATS_SINK);
 
   SliceTag sliceTag;
   if (packet->PeekPacketTag (sliceTag))
@@ -279,48 +632,38 @@ NetworkStatistics::TableDropPacket (
 
       Ptr<FlowStatsCalculator> slcStats = m_slices [sliceId].flowStats [qosType];
       slcStats->NotifyDrop (packet->GetSize (), FlowStatsCalculator::TABLE);
-
-      Ptr<FlowStatsCalculator> aggStats = m_slices [0].flowStats [qosType];
-      aggStats->NotifyDrop (packet->GetSize (), FlowStatsCalculator::TABLE);
     }
 }
 
 void
-NetworkStatistics::TxPacket (std::string context, Ptr<const Packet> packet)
+NetworkStatistics::TxPacket (Ptr<const Packet> packet, uint8_t sliceId,
+                             TQosType ttype)
 {
-  NS_LOG_FUNCTION (this << context << packet);
-
-  SliceTag sliceTag;
-  if (packet->PeekPacketTag (sliceTag))
-    {
-      uint16_t sliceId = sliceTag.GetSliceId ();
-      TQosType qosType = sliceTag.GetTQosType ();
+  NS_LOG_FUNCTION (this << packet << static_cast<uint16_t> (sliceId) << ttype);
 
+  RuntimeProfiler::Scope profScope (RuntimeProfiler::STATS_SINK);
 
-      Ptr<FlowStatsCalculator> slcStats = m_slices [sliceId].flowStats [qosType];
-      slcStats->NotifyTx (packet->GetSize ());
-
-      Ptr<FlowStatsCalculator> aggStats = m_slices [0].flowStats [qosType];
-      aggStats->NotifyTx (packet->GetSize ());
-    }
+  Ptr<FlowStatsCalculator> slcStats = m_slices [sliceId].flowStats [ttype];
+  slcStats->NotifyTx (packet->GetSize ());
 }
 
 void
-NetworkStatistics::RxPacket (std::string context, Ptr<const Packet> packet)
+NetworkStatistics::RxPacket (Ptr<const Packet> packet, uint8_t sliceId,
+                             TQosType ttype)
 {
-  NS_LOG_FUNCTION (this << context << packet);
+  NS_LOG_FUNCTION (this << packet << static_cast<uint16_t> (sliceId) << ttype);
 
+  RuntimeProfiler::Scope profScope (RuntimeProfiler::STATS_SINK);
+
+  // The slice tag is still required for the packet timestamp.
   SliceTag sliceTag;
   if (packet->PeekPacketTag (sliceTag))
     {
-      uint16_t sliceId = sliceTag.GetSliceId ();
-      TQosType qosType = sliceTag.GetTQosType ();
-
-      Ptr<FlowStatsCalculator> slcStats = m_slices [sliceId].flowStats [qosType];
+      Ptr<FlowStatsCalculator> slcStats = m_slices [sliceId].flowStats [ttype];
       slcStats->NotifyRx (packet->GetSize (), sliceTag.GetTimestamp ());
 
-      Ptr<FlowStatsCalculator> aggStats = m_slices [0].flowStats [qosType];
-      aggStats->NotifyRx (packet->GetSize (), sliceTag.GetTimestamp ());
+      Ptr<FlowStatsCalculator> aggStats = m_slices [0].flowStats [ttype];
+      aggStats->NotifyRxJitter (sliceTag.GetTimestamp ());
     }
 }
 
@@ -24,7 +24,10 @@
 #include <ns3/core-module.h>
 #include <ns3/network-module.h>
 #include <ns3/ofswitch13-device-container.h>
+#include "binary-stats-writer.h"
 #include "flow-stats-calculator.h"
+#include "../application/udp-aggregate-app.h"
+#include "../application/udp-peer-app.h"
 #include "../metadata/slice-tag.h"
 #include "../metadata/link-info.h"
 
@@ -37,6 +40,14 @@ namespace ns3 {
 class NetworkStatistics : public Object
 {
 public:
+  /** Output format for statistics. */
+  enum OutputFormat
+  {
+    TEXT   = 0,   //!< Per-slice text log files.
+    BINARY = 1,   //!< Single binary file for all slices.
+    BOTH   = 2    //!< Both text and binary outputs.
+  };
+
   NetworkStatistics ();          //!< Default constructor.
   virtual ~NetworkStatistics (); //!< Dummy destructor, see DoDispose.
 
@@ -46,6 +57,22 @@ public:
    */
   static TypeId GetTypeId (void);
 
+  /**
+   * Connect the TX and RX trace sources of a UDP peer (or aggregated)
+   * application directly to this stats calculator. Applications already
+   * installed when this object is created are registered by the constructor.
+   * \param app The UDP peer application.
+   */
+  void RegisterApp (Ptr<Application> app);
+
+  /**
+   * Connect the drop trace sources of an OpenFlow switch device and its port
+   * queues directly to this stats calculator. Switches already installed
+   * when this object is created are registered by the constructor.
+   * \param device The OpenFlow switch device.
+   */
+  void RegisterSwitch (Ptr<OFSwitch13Device> device);
+
 protected:
   /** Destructor implementation. */
   virtual void DoDispose ();
@@ -54,65 +81,136 @@ protected:
   virtual void NotifyConstructionCompleted (void);
 
 private:
+  /** Statistics sampled for all slices at the end of a dump interval. */
+  struct StatsSample
+  {
+    Time                  time;       //!< Sample time.
+    bool                  written;    //!< Sample already written.
+    std::vector<int64_t>  bwdValues;  //!< Bandwidth values.
+    std::vector<int64_t>  tffValues;  //!< Traffic values.
+  };
+
   /**
-   * Dump statistics into file.
+   * Sample statistics at the end of each dump interval, writing them into
+   * files or keeping them in the detail history, depending on the
+   * DetailHistory attribute. Aggregated statistics are updated too.
    */
   void DumpStatistics (void);
 
+  /**
+   * Fill the sample with current values for all slices. Aggregated samples
+   * get the aggregated flow stats and the bandwidth values averaged over the
+   * dump intervals in the aggregate window.
+   * \param sample The sample to fill.
+   * \param aggregate True for the aggregated sample.
+   */
+  void FillSample (StatsSample &sample, bool aggregate);
+
+  /**
+   * Write the sample into output files, depending on the OutputFormat
+   * attribute, and mark it as written.
+   * \param sample The sample to write.
+   * \param aggregate True to write into aggregated output files.
+   */
+  void WriteSample (StatsSample &sample, bool aggregate);
+
+  /**
+   * Write the sample into text files, using the LinkInfo and
+   * FlowStatsCalculator value printers.
+   * \param sample The sample to write.
+   * \param aggregate True to write into aggregated output files.
+   */
+  void WriteTextSample (const StatsSample &sample, bool aggregate);
+
+  /**
+   * Write the sample into the binary file.
+   * \param sample The sample to write.
+   * \param aggregate True to use the aggregated record types.
+   */
+  void WriteBinarySample (const StatsSample &sample, bool aggregate);
+
+  /**
+   * Write all samples in the detail history not yet written, and keep
+   * writing the following samples for the length of the detail history.
+   */
+  void FlushDetail (void);
+
+  /**
+   * Trace sink fired when the extra bit rate of a slice changes.
+   * \param dir The link direction.
+   * \param slice The network slice.
+   * \param bitRate The new extra bit rate.
+   */
+  void ExtraBitRateChanged (LinkInfo::LinkDir dir, int slice, int64_t bitRate);
+
   /**
    * Trace sink fired when a packet is dropped while exceeding pipeline load capacity.
-   * \param context Context information.
    * \param packet The dropped packet.
    */
-  void OverloadDropPacket (std::string context, Ptr<const Packet> packet);
+  void OverloadDropPacket (Ptr<const Packet> packet);
 
   /**
    * Trace sink fired when a packets is dropped by meter band.
-   * \param context Context information.
    * \param packet The dropped packet.
    * \param meterId The meter ID that dropped the packet.
    */
-  void MeterDropPacket (std::string context, Ptr<const Packet> packet, uint32_t meterId);
+  void MeterDropPacket (Ptr<const Packet> packet, uint32_t meterId);
 
   /**
    * Trace sink fired when a packet is dropped by OpenFlow port queues.
-   * \param context Context information.
    * \param packet The dropped packet.
    */
-  void QueueDropPacket (std::string context, Ptr<const Packet> packet);
+  void QueueDropPacket (Ptr<const Packet> packet);
 
   /**
    * Trace sink fired when an unmatched packets is dropped by a flow table.
-   * \param context Context information.
    * \param packet The dropped packet.
    * \param tableId The flow table ID that dropped the packet.
    */
-  void TableDropPacket (std::string context, Ptr<const Packet> packet, uint8_t tableId);
+  void TableDropPacket (Ptr<const Packet> packet, uint8_t tableId);
 
   /**
    * Trace sink fired when a packet enters the EPC.
-   * \param context Context information.
    * \param packet The packet.
+   * \param sliceId The slice ID.
+   * \param ttype The traffic type.
    */
-  void TxPacket (std::string context, Ptr<const Packet> packet);
+  void TxPacket (Ptr<const Packet> packet, uint8_t sliceId, TQosType ttype);
 
   /**
    * Trace sink fired when a packet leaves the EPC.
-   * \param context Context information.
    * \param packet The packet.
+   * \param sliceId The slice ID.
+   * \param ttype The traffic type.
    */
-  void RxPacket (std::string context, Ptr<const Packet> packet);
+  void RxPacket (Ptr<const Packet> packet, uint8_t sliceId, TQosType ttype);
 
   /** Metadata associated to a network slice. */
   struct SliceMetadata
   {
     Ptr<OutputStreamWrapper>  bwdWrapper;               //!< BwdStats file wrapper.
     Ptr<OutputStreamWrapper>  tffWrapper;               //!< FlwStats file wrapper.
+    Ptr<OutputStreamWrapper>  bwdAggWrapper;            //!< Aggregated BwdStats.
+    Ptr<OutputStreamWrapper>  tffAggWrapper;            //!< Aggregated FlwStats.
     Ptr<FlowStatsCalculator>  flowStats [N_TRAFFIC_TYPES];  //!< Flow stats calculator.
+    Ptr<FlowStatsCalculator>  aggStats [N_TRAFFIC_TYPES];   //!< Aggregated stats.
   };
 
   std::string     m_bwdFilename;          //!< BwdStats filename.
   std::string     m_tffFilename;          //!< TffStats filename.
+  std::string     m_binFilename;          //!< Binary stats filename.
+  uint32_t        m_binBufSize;           //!< Binary stats buffer size.
+  OutputFormat    m_format;               //!< Output format.
+  Ptr<BinaryStatsWriter> m_binWriter;     //!< Binary stats writer.
+  Time            m_dumpTimeout;          //!< Dump interval.
+  uint32_t        m_detailHistory;        //!< Number of detail samples.
+  uint32_t        m_aggIntervals;         //!< Dump intervals per aggregate.
+  uint32_t        m_aggCounter;           //!< Dump intervals since aggregate.
+  Time            m_detailUntil;          //!< Write detail samples until.
+  std::vector<StatsSample> m_detail;      //!< Detail history ring buffer.
+  size_t          m_detailNext;           //!< Next detail history index.
+  StatsSample     m_aggSample;            //!< Aggregated sample.
+  std::vector<int64_t> m_aggBwdSum;       //!< Aggregated bandwidth sums.
   SliceMetadata   m_slices [SLICE_ALL];   // Slice metadata
 };
 
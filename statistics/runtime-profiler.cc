@@ -0,0 +1,269 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Thiago Guimarães <thiago.guimaraes@ice.ufjf.br>
+ *         Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+#include <iomanip>
+#include "runtime-profiler.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("RuntimeProfiler");
+NS_OBJECT_ENSURE_REGISTERED (ProfilingScheduler);
+
+// Initializing RuntimeProfiler static members.
+bool RuntimeProfiler::m_enabled = false;
+RuntimeProfiler::Scope *RuntimeProfiler::m_current = 0;
+RuntimeProfiler::Counters RuntimeProfiler::m_counters [N_PROFILER_COMPONENTS];
+RuntimeProfiler::Counters RuntimeProfiler::m_lastCounters [N_PROFILER_COMPONENTS];
+std::chrono::steady_clock::time_point RuntimeProfiler::m_wallStart;
+int64_t RuntimeProfiler::m_lastWallNs = 0;
+uint64_t RuntimeProfiler::m_lastEvents = 0;
+
+void
+RuntimeProfiler::Enable (Time interval)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  NS_ASSERT_MSG (!m_enabled, "Runtime profiler already enabled.");
+  m_enabled = true;
+  m_wallStart = std::chrono::steady_clock::now ();
+  m_lastEvents = Simulator::GetEventCount ();
+
+  // The profiling scheduler is a MapScheduler, so replacing any other
+  // configured scheduler would profile a different event queue.
+  TypeIdValue schedulerType;
+  GlobalValue::GetValueByName ("SchedulerType", schedulerType);
+  NS_ABORT_MSG_IF (schedulerType.Get () != MapScheduler::GetTypeId (),
+                   "Runtime profiler requires the ns3::MapScheduler, but "
+                   "SchedulerType is " << schedulerType.Get ().GetName ());
+
+  // Events already scheduled are moved into the new scheduler.
+  ObjectFactory schedulerFactory;
+  schedulerFactory.SetTypeId (ProfilingScheduler::GetTypeId ());
+  Simulator::SetScheduler (schedulerFactory);
+
+  if (!interval.IsZero ())
+    {
+      Simulator::Schedule (interval, &RuntimeProfiler::PeriodicReport,
+                           interval);
+    }
+}
+
+bool
+RuntimeProfiler::IsEnabled (void)
+{
+  return m_enabled;
+}
+
+void
+RuntimeProfiler::PrintReport (std::ostream &os)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  if (!m_enabled)
+    {
+      return;
+    }
+
+  int64_t wallNs = GetWallNs ();
+  uint64_t events = Simulator::GetEventCount ();
+  double wallSecs = static_cast<double> (wallNs) / 1e9;
+  double simSecs = Simulator::Now ().GetSeconds ();
+
+  os << "Profiler summary:" << std::fixed << std::setprecision (3)
+     << " wall " << wallSecs << "s"
+     << " sim " << simSecs << "s"
+     << " events " << events
+     << " events/s " << std::setprecision (0)
+     << (wallSecs > 0 ? events / wallSecs : 0)
+     << " queue peak " << ProfilingScheduler::GetPeakSize ()
+     << std::endl;
+
+  os << std::left
+     << std::setw (14) << "Component"
+     << std::right
+     << std::setw (12) << "Calls"
+     << std::setw (12) << "Self(s)"
+     << std::setw (12) << "ns/call"
+     << std::setw (10) << "Wall(%)"
+     << std::endl;
+
+  int64_t profiledNs = 0;
+  for (int c = 0; c < N_PROFILER_COMPONENTS; c++)
+    {
+      const Counters &counters = m_counters [c];
+      profiledNs += counters.selfNs;
+      os << std::left
+         << std::setw (14) << ComponentStr (static_cast<Component> (c))
+         << std::right
+         << std::setw (12) << counters.calls
+         << std::setw (12) << std::setprecision (3)
+         << static_cast<double> (counters.selfNs) / 1e9
+         << std::setw (12) << std::setprecision (0)
+         << (counters.calls ? static_cast<double> (counters.selfNs) / counters.calls : 0)
+         << std::setw (10) << std::setprecision (1)
+         << (wallNs ? 100.0 * counters.selfNs / wallNs : 0)
+         << std::endl;
+    }
+
+  // Everything else: simulator core, sockets, IP stack, OpenFlow pipeline.
+  os << std::left
+     << std::setw (14) << "Other"
+     << std::right
+     << std::setw (12) << "-"
+     << std::setw (12) << std::setprecision (3)
+     << static_cast<double> (wallNs - profiledNs) / 1e9
+     << std::setw (12) << "-"
+     << std::setw (10) << std::setprecision (1)
+     << (wallNs ? 100.0 * (wallNs - profiledNs) / wallNs : 0)
+     << std::endl;
+  os.unsetf (std::ios_base::floatfield);
+  os << std::setprecision (6);
+}
+
+std::string
+RuntimeProfiler::ComponentStr (Component comp)
+{
+  switch (comp)
+    {
+    case RuntimeProfiler::APP_SEND:
+      return "AppSend";
+    case RuntimeProfiler::LINK_TX:
+      return "LinkTx";
+    case RuntimeProfiler::LINK_EWMA:
+      return "LinkEwma";
+    case RuntimeProfiler::STATS_SINK:
+      return "StatsSink";
+    case RuntimeProfiler::STATS_DUMP:
+      return "StatsDump";
+    case RuntimeProfiler::QUEUE_DEQUEUE:
+      return "QueueDequeue";
+    case RuntimeProfiler::CTRL_SLICING:
+      return "CtrlSlicing";
+    default:
+      NS_LOG_ERROR ("Invalid profiler component.");
+      return std::string ();
+    }
+}
+
+void
+RuntimeProfiler::PeriodicReport (Time interval)
+{
+  NS_LOG_FUNCTION (interval);
+
+  int64_t wallNs = GetWallNs ();
+  uint64_t events = Simulator::GetEventCount ();
+  double intervalSecs = static_cast<double> (wallNs - m_lastWallNs) / 1e9;
+
+  std::cout << "Profiler +" << Simulator::Now ().GetSeconds () << "s:"
+            << std::fixed << std::setprecision (3)
+            << " wall " << static_cast<double> (wallNs) / 1e9 << "s"
+            << " events/s " << std::setprecision (0)
+            << (intervalSecs > 0 ? (events - m_lastEvents) / intervalSecs : 0)
+            << " queue " << ProfilingScheduler::GetSize ();
+
+  // Share of the interval wall-clock time for each active component.
+  std::cout << std::setprecision (1);
+  for (int c = 0; c < N_PROFILER_COMPONENTS; c++)
+    {
+      int64_t deltaNs = m_counters [c].selfNs - m_lastCounters [c].selfNs;
+      if (deltaNs > 0 && intervalSecs > 0)
+        {
+          std::cout << " " << ComponentStr (static_cast<Component> (c))
+                    << " " << deltaNs / intervalSecs / 1e7 << "%";
+        }
+      m_lastCounters [c] = m_counters [c];
+    }
+  std::cout << std::endl;
+  std::cout.unsetf (std::ios_base::floatfield);
+  std::cout << std::setprecision (6);
+
+  m_lastWallNs = wallNs;
+  m_lastEvents = events;
+  Simulator::Schedule (interval, &RuntimeProfiler::PeriodicReport, interval);
+}
+
+int64_t
+RuntimeProfiler::GetWallNs (void)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds> (
+    std::chrono::steady_clock::now () - m_wallStart).count ();
+}
+
+
+// ----------------------------------------------------------------------------
+// Initializing ProfilingScheduler static members.
+uint64_t ProfilingScheduler::m_size = 0;
+uint64_t ProfilingScheduler::m_peakSize = 0;
+
+ProfilingScheduler::ProfilingScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+ProfilingScheduler::~ProfilingScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+ProfilingScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ProfilingScheduler")
+    .SetParent<MapScheduler> ()
+    .AddConstructor<ProfilingScheduler> ()
+  ;
+  return tid;
+}
+
+void
+ProfilingScheduler::Insert (const Event &ev)
+{
+  MapScheduler::Insert (ev);
+  m_peakSize = std::max (m_peakSize, ++m_size);
+}
+
+Scheduler::Event
+ProfilingScheduler::RemoveNext (void)
+{
+  m_size--;
+  return MapScheduler::RemoveNext ();
+}
+
+void
+ProfilingScheduler::Remove (const Event &ev)
+{
+  m_size--;
+  MapScheduler::Remove (ev);
+}
+
+uint64_t
+ProfilingScheduler::GetSize (void)
+{
+  return m_size;
+}
+
+uint64_t
+ProfilingScheduler::GetPeakSize (void)
+{
+  return m_peakSize;
+}
+
+} // namespace ns3
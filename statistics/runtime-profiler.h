@@ -0,0 +1,213 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Thiago Guimarães <thiago.guimaraes@ice.ufjf.br>
+ *         Luciano Chaves <luciano.chaves@ice.ufjf.br>
+ */
+
+#ifndef RUNTIME_PROFILER_H
+#define RUNTIME_PROFILER_H
+
+#include <chrono>
+#include <iostream>
+#include <ns3/core-module.h>
+
+namespace ns3 {
+
+/**
+ * Wall-clock profiler for the simulation runtime. When enabled, it reports
+ * the wall-clock time, the number of simulator events per second, the event
+ * queue size, and the time spent in the major simulation callbacks. Each
+ * instrumented callback holds a Scope object that accounts its own time,
+ * excluding the time of any nested instrumented callback, so the reported
+ * shares never overlap. When the profiler is disabled, a scope costs a
+ * single flag check.
+ */
+class RuntimeProfiler
+{
+public:
+  /** The profiled components. */
+  enum Component
+  {
+    APP_SEND      = 0,  //!< UDP apps packet transmission.
+    LINK_TX       = 1,  //!< LinkInfo TX packet accounting.
+    LINK_EWMA     = 2,  //!< LinkInfo EWMA throughput update.
+    STATS_SINK    = 3,  //!< NetworkStatistics trace sinks.
+    STATS_DUMP    = 4,  //!< NetworkStatistics periodic dump.
+    QUEUE_DEQUEUE = 5,  //!< QoS output queue dequeue.
+    CTRL_SLICING  = 6   //!< Controller dynamic slicing.
+  };
+
+  // Total number of valid Component items.
+  #define N_PROFILER_COMPONENTS (static_cast<int> (RuntimeProfiler::CTRL_SLICING) + 1)
+
+  /**
+   * Time accounting for one execution of a profiled component, from the
+   * object construction until its destruction.
+   */
+  class Scope
+  {
+  public:
+    /**
+     * Start accounting the time for this component, if the profiler is on.
+     * \param comp The profiled component.
+     */
+    inline Scope (Component comp);
+    inline ~Scope ();   //!< Stop accounting the time for this component.
+
+  private:
+    typedef std::chrono::steady_clock::time_point TimePoint;
+
+    Component   m_comp;     //!< The profiled component.
+    bool        m_active;   //!< The profiler was enabled at construction.
+    Scope      *m_parent;   //!< The enclosing profiled scope.
+    int64_t     m_childNs;  //!< Time spent in nested scopes (ns).
+    TimePoint   m_start;    //!< Wall-clock start time.
+  };
+
+  /**
+   * Enable the profiler, replacing the simulator scheduler by one that keeps
+   * track of the event queue size. Aborts when the configured SchedulerType is
+   * not the default ns3::MapScheduler.
+   * \param interval The interval for periodic reports (zero for final only).
+   */
+  static void Enable (Time interval);
+
+  /**
+   * Check if the profiler is enabled.
+   * \return True when enabled.
+   */
+  static bool IsEnabled (void);
+
+  /**
+   * Print the final report, with cumulative values for the whole run.
+   * \param os The output stream.
+   */
+  static void PrintReport (std::ostream &os);
+
+  /**
+   * Get the component name.
+   * \param comp The profiled component.
+   * \return The string with the component name.
+   */
+  static std::string ComponentStr (Component comp);
+
+private:
+  /** Accumulated counters for a profiled component. */
+  struct Counters
+  {
+    uint64_t calls;   //!< Number of executions.
+    int64_t  selfNs;  //!< Time excluding nested scopes (ns).
+  };
+
+  /**
+   * Print a single line report for the last interval and schedule the next.
+   * \param interval The report interval.
+   */
+  static void PeriodicReport (Time interval);
+
+  /**
+   * Get the wall-clock time since the profiler was enabled.
+   * \return The elapsed time (ns).
+   */
+  static int64_t GetWallNs (void);
+
+  static bool       m_enabled;      //!< The profiler is enabled.
+  static Scope     *m_current;      //!< The innermost active scope.
+  static Counters   m_counters [N_PROFILER_COMPONENTS]; //!< Totals.
+  static Counters   m_lastCounters [N_PROFILER_COMPONENTS]; //!< Last report.
+  static std::chrono::steady_clock::time_point m_wallStart; //!< Start time.
+  static int64_t    m_lastWallNs;   //!< Wall-clock time at last report.
+  static uint64_t   m_lastEvents;   //!< Event count at last report.
+};
+
+
+/**
+ * Map scheduler keeping track of the number of pending events, used by the
+ * runtime profiler to report the event queue size.
+ */
+class ProfilingScheduler : public MapScheduler
+{
+public:
+  ProfilingScheduler ();            //!< Default constructor.
+  virtual ~ProfilingScheduler ();   //!< Dummy destructor.
+
+  /**
+   * Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  // Inherited from Scheduler.
+  virtual void Insert (const Event &ev);
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+
+  /**
+   * Get the event queue size.
+   * \return The current number of pending events.
+   */
+  static uint64_t GetSize (void);
+
+  /**
+   * Get the event queue peak size.
+   * \return The maximum number of pending events so far.
+   */
+  static uint64_t GetPeakSize (void);
+
+private:
+  static uint64_t m_size;       //!< Number of pending events.
+  static uint64_t m_peakSize;   //!< Maximum number of pending events.
+};
+
+
+// Inline scope implementation, as it runs in the simulation hot paths.
+inline
+RuntimeProfiler::Scope::Scope (Component comp)
+  : m_comp (comp),
+  m_active (RuntimeProfiler::m_enabled),
+  m_parent (0),
+  m_childNs (0)
+{
+  if (m_active)
+    {
+      m_parent = RuntimeProfiler::m_current;
+      RuntimeProfiler::m_current = this;
+      m_start = std::chrono::steady_clock::now ();
+    }
+}
+
+inline
+RuntimeProfiler::Scope::~Scope ()
+{
+  if (m_active)
+    {
+      int64_t elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds> (
+          std::chrono::steady_clock::now () - m_start).count ();
+      Counters &counters = RuntimeProfiler::m_counters [m_comp];
+      counters.calls++;
+      counters.selfNs += elapsedNs - m_childNs;
+      if (m_parent)
+        {
+          m_parent->m_childNs += elapsedNs;
+        }
+      RuntimeProfiler::m_current = m_parent;
+    }
+}
+
+} // namespace ns3
+#endif /* RUNTIME_PROFILER_H */
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation;
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#
+# Author: Luciano Chaves <luciano.chaves@ice.ufjf.br>
+#
+
+"""
+Merge the text statistics written by each rank of a distributed run.
+
+In distributed mode, each MPI rank writes its own traffic and bandwidth
+logs under an 'r<rank>-' output prefix. Packets are counted as transmitted
+at the sender's rank and as received at the receiver's rank, and link usage
+is only seen by the rank simulating the transmitting switch. This tool
+combines the logs of all ranks into the files a sequential run writes:
+
+  traffic    Counters, drops, and throughput are summed, the active time is
+             the maximum, and delay and jitter are averaged weighted by the
+             received packets of each rank. Delay percentiles can't be
+             combined from per-rank percentiles, and the latency histograms
+             are not written to any output, so they are left empty ('-').
+  bandwidth  Link configuration columns come from rank 0, where the
+             controller runs, and usage columns come from the rank with the
+             highest usage for that link direction.
+
+Other outputs (switch statistics, binary statistics) are left per rank.
+
+Distributed runs need ns-3 built with MPI support. The output prefix is the
+simulation prefix followed by the run number, so a two-rank run and merge
+looks like:
+
+  mpirun -np 2 ./PROGRAM --Distributed=true --LinkDelay=1ms \
+                         --Prefix=PREFIX --RngRun=1
+  merge-ranks.py PREFIX-1-
+
+Usage: merge-ranks.py [--ranks N] OUTPUT_PREFIX
+"""
+
+import argparse
+import glob
+import os
+import re
+import sys
+
+STATS_RE = re.compile(r'^(bandwidth|traffic)(-agg)?-\d+\.log$')
+
+TFF_SUM = ('TxPkts', 'RxPkts', 'TxBytes', 'RxBytes', 'ThpKbps', 'DpBytes',
+           'DpPkts', 'DpQue', 'DpSli', 'DpMbr', 'DpLoa', 'DpTab')
+TFF_MAX = ('ActvSec',)
+TFF_RXAVG = ('DlyMsec', 'JitMsec')
+TFF_EMPTY = ('P50Msec', 'P90Msec', 'P99Msec', 'P999Msec')
+BWD_USAGE = ('UseAFKbps', 'UseBEKbps', 'UsePRIOKbps', 'OverKbps', 'IdleKbps')
+BWD_USED = ('UseAFKbps', 'UseBEKbps', 'UsePRIOKbps')
+
+
+def column_widths(header):
+    """Return the width of each column, as printed with setw in the logs."""
+    widths = []
+    last = 0
+    for match in re.finditer(r'\S+', header):
+        widths.append(match.end() - last - 1)
+        last = match.end()
+    return widths
+
+
+def format_value(value, is_float):
+    """Format a merged value like the simulator (fixed, 3 decimals)."""
+    return '%.3f' % value if is_float else '%d' % round(value)
+
+
+def merge_traffic_row(columns, rows):
+    """Merge the traffic rows of all ranks for the same time and type."""
+    rx_pkts = [float(row[columns.index('RxPkts')]) for row in rows]
+    merged = list(rows[0])
+    for i, name in enumerate(columns):
+        if name in TFF_EMPTY:
+            merged[i] = '-'
+            continue
+        if name not in TFF_SUM + TFF_MAX + TFF_RXAVG:
+            continue
+        values = [float(row[i]) for row in rows]
+        if name in TFF_SUM:
+            value = sum(values)
+        elif name in TFF_MAX:
+            value = max(values)
+        elif name in TFF_RXAVG:
+            total = sum(rx_pkts)
+            value = (sum(v * n for v, n in zip(values, rx_pkts)) / total
+                     if total else 0)
+        merged[i] = format_value(value, '.' in rows[0][i])
+    return merged
+
+
+def merge_bandwidth_row(columns, rows):
+    """Merge the bandwidth rows of all ranks for the same link direction."""
+    used = [sum(float(row[columns.index(name)]) for name in BWD_USED)
+            for row in rows]
+    owner = rows[used.index(max(used))]
+    merged = list(rows[0])
+    for name in BWD_USAGE:
+        i = columns.index(name)
+        merged[i] = owner[i]
+    return merged
+
+
+def merge_file(prefix, name, ranks):
+    """Merge one log file from all ranks, returning the number of rows."""
+    logs = []
+    for rank in range(ranks):
+        log_name = '%sr%d-%s' % (prefix, rank, name)
+        if not os.path.exists(log_name):
+            sys.exit('%s: missing log for rank %d' % (log_name, rank))
+        with open(log_name) as log:
+            logs.append(log.read().splitlines())
+    if any(len(lines) != len(logs[0]) for lines in logs):
+        sys.exit('%s: ranks wrote a different number of lines' % name)
+
+    header = logs[0][0]
+    columns = header.split()
+    widths = column_widths(header)
+    merge_row = (merge_traffic_row if name.startswith('traffic')
+                 else merge_bandwidth_row)
+    rows = 0
+    with open(prefix + name, 'w') as out:
+        out.write(header + '\n')
+        for lines in list(zip(*logs))[1:]:
+            values = [line.split() for line in lines]
+            if not values[0]:
+                out.write('\n')
+                continue
+            if any(v[:2] != values[0][:2] for v in values):
+                sys.exit('%s: rows out of sync at %r' % (name, lines[0]))
+            merged = merge_row(columns, values)
+            out.write(''.join(' ' + v.rjust(w)
+                              for v, w in zip(merged, widths)) + '\n')
+            rows += 1
+    return rows
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split('\n')[0])
+    parser.add_argument('prefix', metavar='OUTPUT_PREFIX',
+                        help='output prefix of the distributed run')
+    parser.add_argument('--ranks', type=int, default=2,
+                        help='number of MPI ranks (default 2)')
+    args = parser.parse_args()
+
+    base = args.prefix + 'r0-'
+    names = sorted(log_name[len(base):]
+                   for log_name in glob.glob(glob.escape(base) + '*.log'))
+    names = [name for name in names if STATS_RE.match(name)]
+    if not names:
+        sys.exit('%sr0-*: no text statistics found' % args.prefix)
+    for name in names:
+        rows = merge_file(args.prefix, name, args.ranks)
+        print('Merged %d rows into %s%s' % (rows, args.prefix, name))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,219 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation;
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#
+# Author: Luciano Chaves <luciano.chaves@ice.ufjf.br>
+#
+
+"""
+Run a parameter sweep of simulation scenarios in parallel.
+
+Each job is one (scenario, RngRun) pair, executed as an independent
+simulation process. Idle workers take the next pending job from a shared
+queue, so long runs never hold back the remaining ones, and jobs are sorted
+by their estimated size (total number of apps) so the longest ones start
+first. Each scenario runs in its own directory under the output directory,
+where its .slices and .topo files are linked, keeping the input tree clean.
+
+A job is skipped when its done marker already exists, so an interrupted
+sweep can be resumed by running the same command again. After all jobs
+finish, the per-slice text logs of each run are merged into one table per
+statistic type (sweep-traffic.tsv and sweep-bandwidth.tsv), with the
+scenario, run, and slice columns prepended to each row.
+
+The simulation binary must be runnable as is (for waf builds, export the
+library path or use the binary under build/ from the ns-3 shell).
+
+Usage: run-sweep.py --binary PROGRAM [--scenarios NAME ...] [--runs A-B]
+                    [--jobs N] [--outdir DIR] [-- EXTRA_ARGS ...]
+"""
+
+import argparse
+import glob
+import os
+import queue
+import re
+import subprocess
+import sys
+import threading
+import time
+
+STATS_TYPES = ('traffic', 'bandwidth')
+
+
+def parse_runs(spec):
+    """Parse a run list like '1-10' or '1,3,5-7' into a sorted list."""
+    runs = set()
+    for part in spec.split(','):
+        first, _, last = part.partition('-')
+        runs.update(range(int(first), int(last or first) + 1))
+    return sorted(runs)
+
+
+def estimate_cost(slices_file):
+    """Estimate the scenario size as the total number of apps."""
+    cost = 0
+    with open(slices_file) as f:
+        for line in f:
+            hosts = re.search(r'NumHostsA=(\d+)', line)
+            hosts = int(hosts.group(1)) if hosts else 1
+            for num_apps in re.findall(r'\{\s*(\d+)\s*,', line):
+                cost += int(num_apps) * hosts
+    return cost
+
+
+def find_scenarios(basedir, names):
+    """Map scenario names to their input prefixes (without extension)."""
+    scenarios = {}
+    for slices_file in sorted(glob.glob(os.path.join(basedir, '*', '*.slices'))):
+        name = os.path.splitext(os.path.basename(slices_file))[0]
+        if not names or name in names:
+            scenarios[name] = os.path.abspath(slices_file[:-len('.slices')])
+    missing = set(names or ()) - set(scenarios)
+    if missing:
+        sys.exit('Unknown scenarios: %s' % ', '.join(sorted(missing)))
+    return scenarios
+
+
+def prepare_dir(outdir, name, input_prefix):
+    """Create the scenario run directory, linking its input files."""
+    rundir = os.path.join(outdir, name)
+    os.makedirs(rundir, exist_ok=True)
+    for ext in ('.slices', '.topo'):
+        src = input_prefix + ext
+        dst = os.path.join(rundir, name + ext)
+        if os.path.exists(src) and not os.path.lexists(dst):
+            os.symlink(src, dst)
+    return os.path.join(rundir, name)
+
+
+def run_job(binary, prefix, run, extra):
+    """Run a single simulation, returning (success, wall time)."""
+    log_name = '%s-%d-stdout.log' % (prefix, run)
+    cmd = [binary, '--Prefix=' + prefix, '--RngRun=%d' % run] + extra
+    start = time.time()
+    with open(log_name, 'w') as log:
+        status = subprocess.call(cmd, stdout=log, stderr=subprocess.STDOUT,
+                                 cwd=os.path.dirname(prefix))
+    return status == 0, time.time() - start
+
+
+def merge_logs(outdir, jobs):
+    """Merge the per-run text logs into one table per statistic type."""
+    for stats in STATS_TYPES:
+        out_name = os.path.join(outdir, 'sweep-%s.tsv' % stats)
+        header = None
+        rows = 0
+        with open(out_name, 'w') as out:
+            for name, prefix, run in sorted(jobs):
+                base = '%s-%d-%s-' % (prefix, run, stats)
+                for log_name in sorted(glob.glob(glob.escape(base) + '*.log')):
+                    # Keep only '<base><slice>.log', skipping the aggregated
+                    # interval logs '<base>agg-<slice>.log'.
+                    slc = log_name[len(base):-len('.log')]
+                    if not slc.isdigit():
+                        continue
+                    with open(log_name) as log:
+                        lines = iter(log)
+                        columns = next(lines, '').split()
+                        if header is None:
+                            header = columns
+                            out.write('\t'.join(['Scenario', 'Run', 'Slice']
+                                                + header) + '\n')
+                        elif columns != header:
+                            sys.exit('%s: unexpected columns' % log_name)
+                        for line in lines:
+                            values = line.split()
+                            if values:
+                                out.write('\t'.join([name, str(run), slc]
+                                                    + values) + '\n')
+                                rows += 1
+        print('Merged %d rows into %s' % (rows, out_name))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split('\n')[0])
+    parser.add_argument('--binary', required=True,
+                        help='simulation program to run')
+    parser.add_argument('--basedir', default='arquivosSimulacoes',
+                        help='scenarios directory (default arquivosSimulacoes)')
+    parser.add_argument('--scenarios', nargs='*', metavar='NAME',
+                        help='scenario names (default all)')
+    parser.add_argument('--runs', default='1',
+                        help='RngRun values, as in 1-10 or 1,3,5 (default 1)')
+    parser.add_argument('--jobs', type=int, default=os.cpu_count(),
+                        help='parallel jobs (default number of cores)')
+    parser.add_argument('--outdir', default='sweep-results',
+                        help='output directory (default sweep-results)')
+    parser.add_argument('extra', nargs='*', metavar='EXTRA_ARGS',
+                        help='extra arguments for every simulation')
+    args = parser.parse_args()
+
+    binary = os.path.abspath(args.binary)
+    outdir = os.path.abspath(args.outdir)
+    scenarios = find_scenarios(args.basedir, args.scenarios)
+
+    # Build the job list, skipping runs already done.
+    jobs, pending = [], []
+    for name, input_prefix in scenarios.items():
+        prefix = prepare_dir(outdir, name, input_prefix)
+        cost = estimate_cost(input_prefix + '.slices')
+        for run in parse_runs(args.runs):
+            jobs.append((name, prefix, run))
+            if not os.path.exists('%s-%d-done' % (prefix, run)):
+                pending.append((cost, name, prefix, run))
+    pending.sort(key=lambda job: -job[0])
+    print('%d jobs, %d already done' % (len(jobs), len(jobs) - len(pending)))
+
+    job_queue = queue.Queue()
+    for job in pending:
+        job_queue.put(job)
+    failed = []
+    lock = threading.Lock()
+
+    def worker():
+        while True:
+            try:
+                _, name, prefix, run = job_queue.get_nowait()
+            except queue.Empty:
+                return
+            ok, wall = run_job(binary, prefix, run, args.extra)
+            with lock:
+                if ok:
+                    open('%s-%d-done' % (prefix, run), 'w').close()
+                else:
+                    failed.append((name, run))
+                print('%s run %d %s in %.1f s' %
+                      (name, run, 'done' if ok else 'FAILED', wall))
+                sys.stdout.flush()
+
+    threads = [threading.Thread(target=worker)
+               for _ in range(max(1, min(args.jobs, len(pending))))]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    failed_set = set(failed)
+    merge_logs(outdir, [job for job in jobs
+                        if (job[0], job[2]) not in failed_set])
+    if failed:
+        sys.exit('%d jobs failed: %s' % (len(failed), ', '.join(
+            '%s/%d' % job for job in failed)))
+
+
+if __name__ == '__main__':
+    main()
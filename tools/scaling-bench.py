@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation;
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#
+# Author: Luciano Chaves <luciano.chaves@ice.ufjf.br>
+#
+
+"""
+Generate synthetic scenarios and measure the simulation cost as they scale.
+
+The 'generate' command writes one .slices/.topo pair for a given number of
+slices, hosts per slice, apps per host and offered load factor. Slices split
+the link quota evenly, and each slice has one group of always-on apps whose
+data rate makes the slice offered load equal to the load factor times its
+quota bit rate on the 160 Mbps switch link.
+
+The 'run' command generates one scenario for each point of the parameter
+grid and runs the simulation for each of them, one at a time so they don't
+compete for the CPU. For each point, it records the wall-clock time, the
+peak resident set size, and the number of simulator events processed
+(reported by the --Profile runtime profiler) into scaling.tsv, which gives
+the simulation cost against network size.
+
+Usage: scaling-bench.py generate --slices N --hosts N --apps N --load F
+                                 [--simtime S] [--output PREFIX]
+       scaling-bench.py run --binary PROGRAM [--slices N,...] [--hosts N,...]
+                            [--apps N,...] [--load F,...] [--simtime S]
+                            [--outdir DIR] [-- EXTRA_ARGS ...]
+"""
+
+import argparse
+import itertools
+import os
+import re
+import subprocess
+import sys
+import time
+
+LINK_KBPS = 160000      # Switch link data rate (see main.cc).
+MAX_SLICES = 14         # N_MAX_SLICES in common.h.
+MAX_HOSTS = 255         # NumHostsA attribute limit.
+
+TOPO_DEFAULTS = [
+    ('ns3::Controller::ExtraStep', '12Mbps'),
+    ('ns3::Controller::GuardStep', '5Mbps'),
+    ('ns3::Controller::MeterStep', '2Mbps'),
+    ('ns3::Controller::SliceMode', 'dynamic'),
+    ('ns3::Controller::SliceTimeout', '20s'),
+    ('ns3::Controller::SpareUse', 'on'),
+    ('ns3::OFSwitch13Port::QueueFactory', 'ns3::QosQueue'),
+]
+
+
+def scenario_name(slices, hosts, apps, load):
+    """Name a scenario after its parameters."""
+    return 'scale-s%d-h%d-a%d-l%g' % (slices, hosts, apps, load)
+
+
+def generate(prefix, slices, hosts, apps, load, simtime):
+    """Write the .slices and .topo files for one scenario."""
+    if not 1 <= slices <= MAX_SLICES:
+        sys.exit('Invalid number of slices: %d' % slices)
+    if not 1 <= hosts <= MAX_HOSTS:
+        sys.exit('Invalid number of hosts per slice: %d' % hosts)
+    if apps < 1 or load <= 0:
+        sys.exit('Invalid number of apps or load factor')
+
+    quota = 100 // slices
+    rate = load * LINK_KBPS * quota / 100.0 / (hosts * apps)
+    with open(prefix + '.slices', 'w') as f:
+        for slc in range(1, slices + 1):
+            # BE apps starting within the first seconds, with traffic length
+            # (normal, 10 s deviation) past the end of the simulation.
+            apps_config = '({%d,%g,1,0,%d,0,0,BE,1,};)' % (
+                apps, rate, simtime + 30)
+            f.write('ns3::SliceInfo[AppsConfig=%s|NumHostsA=%d|NumHostsB=0|'
+                    'Quota=%d|Sharing=on|Priority=%d]\n'
+                    % (apps_config, hosts, quota, 1 + slc % 3))
+    with open(prefix + '.topo', 'w') as f:
+        for name, value in TOPO_DEFAULTS:
+            f.write('default %s "%s"\n' % (name, value))
+        f.write('global SimTime "%ds"\n' % simtime)
+
+
+def run_point(binary, prefix, extra):
+    """Run one simulation, returning (status, wall time, peak RSS, events)."""
+    log_name = prefix + '-stdout.log'
+    cmd = [binary, '--Prefix=' + prefix, '--Progress=0', '--Profile=true']
+    start = time.time()
+    with open(log_name, 'w') as log:
+        proc = subprocess.Popen(cmd + extra, stdout=log,
+                                stderr=subprocess.STDOUT,
+                                cwd=os.path.dirname(prefix))
+        _, status, usage = os.wait4(proc.pid, 0)
+    wall = time.time() - start
+
+    events = None
+    with open(log_name) as log:
+        for line in log:
+            match = re.search(r'Profiler summary:.* events (\d+)', line)
+            if match:
+                events = int(match.group(1))
+
+    # Linux reports the maximum resident set size in kilobytes.
+    code = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -1
+    return code, wall, usage.ru_maxrss, events
+
+
+def int_list(spec):
+    return [int(v) for v in spec.split(',')]
+
+
+def float_list(spec):
+    return [float(v) for v in spec.split(',')]
+
+
+def cmd_generate(args):
+    generate(args.output, args.slices, args.hosts, args.apps, args.load,
+             args.simtime)
+    print('Wrote %s.slices and %s.topo' % (args.output, args.output))
+
+
+def cmd_run(args):
+    binary = os.path.abspath(args.binary)
+    outdir = os.path.abspath(args.outdir)
+    os.makedirs(outdir, exist_ok=True)
+
+    out_name = os.path.join(outdir, 'scaling.tsv')
+    with open(out_name, 'w') as out:
+        out.write('\t'.join(['Slices', 'Hosts', 'Apps', 'Load', 'TotalHosts',
+                             'TotalApps', 'Status', 'WallSecs', 'PeakRssKB',
+                             'Events', 'EventsPerSec']) + '\n')
+        for slices, hosts, apps, load in itertools.product(
+                args.slices, args.hosts, args.apps, args.load):
+            name = scenario_name(slices, hosts, apps, load)
+            rundir = os.path.join(outdir, name)
+            os.makedirs(rundir, exist_ok=True)
+            prefix = os.path.join(rundir, name)
+            generate(prefix, slices, hosts, apps, load, args.simtime)
+
+            status, wall, rss, events = run_point(binary, prefix, args.extra)
+            rate = '%.0f' % (events / wall) if events and wall > 0 else '-'
+            out.write('\t'.join(str(v) for v in [
+                slices, hosts, apps, load, 2 * slices * hosts,
+                slices * hosts * apps, status, '%.3f' % wall, rss,
+                events if events is not None else '-', rate]) + '\n')
+            out.flush()
+            print('%s %s in %.1f s, %d KB, %s events' % (
+                name, 'done' if status == 0 else 'FAILED', wall, rss,
+                events if events is not None else 'unknown'))
+            sys.stdout.flush()
+    print('Results in %s' % out_name)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split('\n')[0])
+    sub = parser.add_subparsers(dest='command')
+    sub.required = True
+
+    gen = sub.add_parser('generate', help='write one scenario')
+    gen.add_argument('--slices', type=int, required=True)
+    gen.add_argument('--hosts', type=int, required=True,
+                     help='hosts per slice at each switch')
+    gen.add_argument('--apps', type=int, required=True,
+                     help='apps per host pair')
+    gen.add_argument('--load', type=float, required=True,
+                     help='offered load over the slice quota bit rate')
+    gen.add_argument('--simtime', type=int, default=10,
+                     help='simulation time in seconds (default 10)')
+    gen.add_argument('--output', default='scenario',
+                     help='output filename prefix (default scenario)')
+    gen.set_defaults(func=cmd_generate)
+
+    run = sub.add_parser('run', help='generate and run a parameter grid')
+    run.add_argument('--binary', required=True,
+                     help='simulation program to run')
+    run.add_argument('--slices', type=int_list, default=[1, 2, 4],
+                     help='slice counts (default 1,2,4)')
+    run.add_argument('--hosts', type=int_list, default=[4, 16, 64],
+                     help='hosts per slice (default 4,16,64)')
+    run.add_argument('--apps', type=int_list, default=[1, 4],
+                     help='apps per host pair (default 1,4)')
+    run.add_argument('--load', type=float_list, default=[0.5, 1.0],
+                     help='load factors (default 0.5,1.0)')
+    run.add_argument('--simtime', type=int, default=10,
+                     help='simulation time in seconds (default 10)')
+    run.add_argument('--outdir', default='scaling-results',
+                     help='output directory (default scaling-results)')
+    run.add_argument('extra', nargs='*', metavar='EXTRA_ARGS',
+                     help='extra arguments for every simulation')
+    run.set_defaults(func=cmd_run)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020 Federal University of Juiz de Fora (UFJF)
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation;
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#
+# Author: Luciano Chaves <luciano.chaves@ice.ufjf.br>
+#
+
+"""
+Convert pcap or CSV traffic captures into the binary trace format replayed
+by UdpPeerApp (see application/trace-replay-file.h).
+
+CSV input lines are 'time,size[,slice]', with time in seconds and an
+optional header line, where size is the UDP payload size. Classic pcap
+files (not pcapng) are supported, with all packets assigned to the --slice
+slice. For pcap input, the size is the transport payload size computed from
+the IP header lengths, as UdpPeerApp adds its own headers; non-IP packets and
+packets without payload are skipped. Packet times are shifted so the trace
+starts at zero.
+
+Usage: trace-converter.py [--slice N] [--output FILE] INPUT [INPUT ...]
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+TRACE_FILE_MAGIC = b'SLCTRACE'
+TRACE_FILE_VERSION = 1
+TRACE_FILE_N_SLICES = 16
+TRACE_FILE_HDR_SIZE = 16 + 16 * TRACE_FILE_N_SLICES
+RECORD = struct.Struct('<QII')
+
+PCAP_MAGICS = {
+    b'\xd4\xc3\xb2\xa1': ('<', 1000),   # Little-endian, microseconds.
+    b'\xa1\xb2\xc3\xd4': ('>', 1000),   # Big-endian, microseconds.
+    b'\x4d\x3c\xb2\xa1': ('<', 1),      # Little-endian, nanoseconds.
+    b'\xa1\xb2\x3c\x4d': ('>', 1),      # Big-endian, nanoseconds.
+}
+
+
+LINKTYPE_ETHERNET = 1
+LINKTYPE_RAW = 101
+LINKTYPE_LINUX_SLL = 113
+LINKTYPE_IPV4 = 228
+LINKTYPE_IPV6 = 229
+
+ETHERTYPE_VLAN = (0x8100, 0x88a8)
+ETHERTYPE_IPV4 = 0x0800
+ETHERTYPE_IPV6 = 0x86dd
+
+IPPROTO_TCP = 6
+IPPROTO_UDP = 17
+
+
+def ip_offset(linktype, frame):
+    """Return the offset of the IP header in the captured frame, or None."""
+    if linktype in (LINKTYPE_RAW, LINKTYPE_IPV4, LINKTYPE_IPV6):
+        return 0
+    if linktype == LINKTYPE_ETHERNET:
+        offset, type_pos = 14, 12
+    elif linktype == LINKTYPE_LINUX_SLL:
+        offset, type_pos = 16, 14
+    else:
+        return None
+    if len(frame) < offset:
+        return None
+    ethertype = struct.unpack_from('>H', frame, type_pos)[0]
+    while ethertype in ETHERTYPE_VLAN and len(frame) >= offset + 4:
+        ethertype = struct.unpack_from('>H', frame, offset + 2)[0]
+        offset += 4
+    if ethertype not in (ETHERTYPE_IPV4, ETHERTYPE_IPV6):
+        return None
+    return offset
+
+
+def payload_size(linktype, frame):
+    """Return the transport payload size of the captured frame, or None."""
+    offset = ip_offset(linktype, frame)
+    if offset is None or len(frame) < offset + 1:
+        return None
+    version = frame[offset] >> 4
+    if version == 4 and len(frame) >= offset + 20:
+        ip_hdr_len = (frame[offset] & 0x0f) * 4
+        ip_len = struct.unpack_from('>H', frame, offset + 2)[0]
+        proto = frame[offset + 9]
+    elif version == 6 and len(frame) >= offset + 40:
+        ip_hdr_len = 40
+        ip_len = 40 + struct.unpack_from('>H', frame, offset + 4)[0]
+        proto = frame[offset + 6]
+    else:
+        return None
+    l4 = offset + ip_hdr_len
+    if proto == IPPROTO_UDP:
+        l4_hdr_len = 8
+    elif proto == IPPROTO_TCP:
+        # Use the TCP data offset when captured, else the minimum header.
+        l4_hdr_len = (frame[l4 + 12] >> 4) * 4 if len(frame) > l4 + 12 else 20
+    else:
+        l4_hdr_len = 0
+    return max(ip_len - ip_hdr_len - l4_hdr_len, 0)
+
+
+def read_pcap(filename, slice_id):
+    """Yield (time_ns, size, slice) tuples from a classic pcap file."""
+    with open(filename, 'rb') as f:
+        header = f.read(24)
+        if len(header) < 24 or header[:4] not in PCAP_MAGICS:
+            sys.exit('%s: not a classic pcap file' % filename)
+        endian, scale = PCAP_MAGICS[header[:4]]
+        linktype = struct.unpack(endian + 'I', header[20:24])[0] & 0xffff
+        pkt_header = struct.Struct(endian + 'IIII')
+        skipped = 0
+        while True:
+            data = f.read(pkt_header.size)
+            if len(data) < pkt_header.size:
+                break
+            sec, frac, incl_len, orig_len = pkt_header.unpack(data)
+            size = payload_size(linktype, f.read(incl_len))
+            if not size:
+                skipped += 1
+                continue
+            yield (sec * 1000000000 + frac * scale, size, slice_id)
+        if skipped:
+            print('%s: skipped %d packets without IP payload' %
+                  (filename, skipped), file=sys.stderr)
+
+
+def read_csv(filename, slice_id):
+    """Yield (time_ns, size, slice) tuples from a CSV file."""
+    with open(filename, newline='') as f:
+        for lineno, row in enumerate(csv.reader(f), 1):
+            if not row or row[0].startswith('#'):
+                continue
+            try:
+                time_ns = int(round(float(row[0]) * 1e9))
+                size = int(row[1])
+                slc = int(row[2]) if len(row) > 2 else slice_id
+            except (ValueError, IndexError):
+                if lineno == 1:
+                    continue    # Header line.
+                sys.exit('%s:%d: invalid record %r' % (filename, lineno, row))
+            yield (time_ns, size, slc)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split('\n')[0])
+    parser.add_argument('inputs', nargs='+', metavar='INPUT',
+                        help='pcap or CSV capture files')
+    parser.add_argument('--slice', type=int, default=1,
+                        help='slice ID for records without one (default 1)')
+    parser.add_argument('--output', default='traffic.trace',
+                        help='output trace file (default traffic.trace)')
+    args = parser.parse_args()
+
+    slices = [[] for _ in range(TRACE_FILE_N_SLICES)]
+    for filename in args.inputs:
+        with open(filename, 'rb') as f:
+            magic = f.read(4)
+        reader = read_pcap if magic in PCAP_MAGICS else read_csv
+        for time_ns, size, slc in reader(filename, args.slice):
+            if not 0 < slc < TRACE_FILE_N_SLICES - 1:
+                sys.exit('%s: invalid slice ID %d' % (filename, slc))
+            slices[slc].append((time_ns, size))
+
+    # Shift packet times so the trace starts at zero.
+    start = min((r[0] for records in slices for r in records), default=0)
+
+    with open(args.output, 'wb') as out:
+        out.write(TRACE_FILE_MAGIC)
+        out.write(struct.pack('<II', TRACE_FILE_VERSION, TRACE_FILE_N_SLICES))
+        offset = TRACE_FILE_HDR_SIZE
+        for records in slices:
+            out.write(struct.pack('<QQ', offset, len(records)))
+            offset += RECORD.size * len(records)
+        for slc, records in enumerate(slices):
+            records.sort()
+            for time_ns, size in records:
+                out.write(RECORD.pack(time_ns - start, size, 0))
+            if records:
+                print('Slice %d: %d packets, %d bytes' %
+                      (slc, len(records), sum(r[1] for r in records)))
+
+
+if __name__ == '__main__':
+    main()